@@ -0,0 +1,29 @@
+#pragma once
+
+#include "common.hpp"
+#include <chrono>
+
+// Minimal timing helpers shared by the microbenchmarks in this directory.
+
+// Keeps the optimizer from discarding a computed value.
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Runs fn once and reports throughput as operations per second, in
+// millions, thousands or units, whichever keeps the figure above one.
+template <typename Fn>
+double runBenchmark(const std::string& label, std::size_t operations, Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double opsPerSecond = operations / seconds;
+    auto [scale, unit] = opsPerSecond >= 1e6 ? std::pair{1e6, " Mops/s"} : opsPerSecond >= 1e3 ? std::pair{1e3, " kops/s"} : std::pair{1.0, "  ops/s"};
+    std::cout << std::left << std::setw(40) << label
+              << std::right << std::setw(10) << std::fixed << std::setprecision(2) << seconds * 1e3 << " ms"
+              << std::setw(14) << std::setprecision(1) << opsPerSecond / scale << unit << std::endl;
+    return opsPerSecond;
+}
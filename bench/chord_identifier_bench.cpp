@@ -0,0 +1,92 @@
+#include "bench.hpp"
+#include "chord_identifier.hpp"
+#include <random>
+
+// A random voicing of three to five notes, as a pitch-class set plus bass
+struct NoteSet {
+    PitchClassSet notes;
+    std::uint8_t bass;
+};
+
+// The obvious approach without a table: test every catalog chord on every
+// root against the set. Each reading must account for every note, allowing
+// only the bass as an extra, and a reading without the fifth only counts
+// when the fifth really is missing from the set.
+static std::size_t identifyByScan(PitchClassSet notes, int bass) {
+    if (!notes.contains(bass)) return 0;
+    std::size_t found = 0;
+    for (const ChordFormula& formula : FormulaCatalog::CHORDS) {
+        PitchClassSet shape(formula.mask);
+        bool canOmitFifth = shape.contains(7) && shape.size() >= 4;
+        for (int root = 0; root < 12; ++root) {
+            PitchClassSet chord = shape.transpose(root);
+            int fifth = (root + 7) % 12;
+            bool onlyBassExtra = notes.without(bass).isSubsetOf(chord);
+            found += onlyBassExtra && chord.isSubsetOf(notes);
+            found += onlyBassExtra && canOmitFifth && !notes.contains(fifth) && chord.without(fifth).isSubsetOf(notes);
+        }
+    }
+    return found;
+}
+
+// Whether any reading of notes over bass is named name
+static bool hasReading(std::initializer_list<int> notes, int bass, std::string_view name) {
+    auto found = ChordIdentifier::instance().identify(PitchClassSet::fromPitchClasses(notes), bass);
+    return std::any_of(found.begin(), found.end(), [&](const ChordMatch& match) { return match.getName() == name; });
+}
+
+int main() {
+    constexpr std::size_t setCount = 10'000'000;
+    constexpr std::size_t scanCount = 1'000'000; // The scan is too slow to run over every set
+
+    std::mt19937 rng(42);
+    std::vector<NoteSet> sets(setCount);
+    for (NoteSet& set : sets) {
+        int size = 3 + static_cast<int>(rng() % 3);
+        int lowest = 127;
+        for (int i = 0; i < size; ++i) {
+            int midi = 40 + static_cast<int>(rng() % 36);
+            set.notes = set.notes.with(midi % 12);
+            lowest = std::min(lowest, midi);
+        }
+        set.bass = static_cast<std::uint8_t>(lowest % 12);
+    }
+
+    runBenchmark("ChordIdentifier table build", 1, [] { doNotOptimize(ChordIdentifier::instance()); });
+
+    std::cout << "Identifying " << setCount << " random note sets" << std::endl;
+
+    std::size_t tableMatches = 0;
+    runBenchmark("ChordIdentifier::identify", setCount, [&] {
+        const ChordIdentifier& identifier = ChordIdentifier::instance();
+        for (const NoteSet& set : sets) {
+            auto found = identifier.identify(set.notes, set.bass);
+            tableMatches += found.size();
+            doNotOptimize(found);
+        }
+    });
+
+    std::size_t scanMatches = 0;
+    runBenchmark("Scan of every chord and root", scanCount, [&] {
+        for (std::size_t i = 0; i < scanCount; ++i) {
+            scanMatches += identifyByScan(sets[i].notes, sets[i].bass);
+        }
+    });
+
+    std::size_t checkedMatches = 0;
+    for (std::size_t i = 0; i < scanCount; ++i) {
+        checkedMatches += ChordIdentifier::instance().identify(sets[i].notes, sets[i].bass).size();
+    }
+
+    // Known answers, and no incomplete reading when the bass is the missing fifth
+    auto dominantOverFifth = ChordIdentifier::instance().identify(PitchClassSet::fromPitchClasses({0, 4, 7, 10}), 7);
+    bool knownAnswers = ChordIdentifier::instance().identify(PitchClassSet::fromPitchClasses({0, 4, 7}), 4).front().getName() == "C/E" &&
+                        hasReading({9, 0, 4, 7}, 0, "Am7/C") && hasReading({0, 4, 10}, 0, "C7(no5)") &&
+                        hasReading({0, 4, 7, 10}, 7, "C7/G") &&
+                        std::none_of(dominantOverFifth.begin(), dominantOverFifth.end(), [](const ChordMatch& match) { return match.omitsFifth; });
+    std::cout << "Known answers (C/E, Am7/C, C7(no5), C7/G without a no5 reading): " << (knownAnswers ? "ok" : "FAILED") << std::endl;
+
+    std::cout << tableMatches << " readings from the table; " << checkedMatches << " from the table and "
+              << scanMatches << " from the scan over the first " << scanCount << " sets" << std::endl;
+    return checkedMatches == scanMatches && knownAnswers ? 0 : 1;
+}
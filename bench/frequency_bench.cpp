@@ -0,0 +1,84 @@
+#include "bench.hpp"
+#include "frequency.hpp"
+#include <cfloat>
+#include <cmath>
+#include <random>
+
+int main() {
+    constexpr std::size_t count = 1 << 22;
+    constexpr int passes = 8;
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> midiDistribution(21.0f, 108.0f);
+    std::vector<float> midi(count), hz(count), roundTrip(count), cents(count);
+    std::vector<std::int32_t> nearest(count);
+    for (auto& value : midi) value = midiDistribution(rng);
+
+    std::cout << "Converting " << count << " pitches x " << passes << " passes" << std::endl;
+
+    runBenchmark("naive std::pow loop", count * passes, [&] {
+        for (int pass = 0; pass < passes; ++pass) {
+            for (std::size_t i = 0; i < count; ++i) {
+                hz[i] = 440.0f * std::pow(2.0f, (midi[i] - 69.0f) / 12.0f);
+            }
+            doNotOptimize(hz.data());
+        }
+    });
+
+    constexpr std::array<std::pair<SimdLevel, std::string_view>, 3> LEVELS = {{
+        {SimdLevel::Scalar, "scalar"}, {SimdLevel::SSE2, "SSE2"}, {SimdLevel::AVX2, "AVX2"}
+    }};
+
+    for (auto [level, label] : LEVELS) {
+        FrequencyConverter converter(FrequencyConverter::CONCERT_A4, level);
+        if (converter.getSimdLevel() != level) continue;
+
+        runBenchmark("midiToHz " + std::string(label), count * passes, [&] {
+            for (int pass = 0; pass < passes; ++pass) {
+                converter.midiToHz(midi, hz);
+                doNotOptimize(hz.data());
+            }
+        });
+
+        runBenchmark("hzToMidi " + std::string(label), count * passes, [&] {
+            for (int pass = 0; pass < passes; ++pass) {
+                converter.hzToMidi(hz, nearest, cents);
+                doNotOptimize(cents.data());
+            }
+        });
+
+        // Round-trip accuracy against exact double-precision arithmetic
+        double worstCents = 0.0;
+        for (std::size_t i = 0; i < count; ++i) {
+            double exact = 440.0 * std::exp2((midi[i] - 69.0) / 12.0);
+            double recovered = nearest[i] + cents[i] / 100.0;
+            worstCents = std::max(worstCents, 1200.0 * std::abs(std::log2(hz[i] / exact)));
+            worstCents = std::max(worstCents, 100.0 * std::abs(recovered - midi[i]));
+        }
+        std::cout << "  worst error " << std::setprecision(5) << worstCents << " cents" << std::endl;
+    }
+
+    // Unusable frequencies map to -1 and 0 cents in the vector lanes and the
+    // scalar tail alike; 19 values put some of each in both
+    constexpr float inf = std::numeric_limits<float>::infinity();
+    const std::vector<float> unusable = {0.0f, -1.0f, std::nanf(""), inf, -inf, FLT_MAX, 1e-30f, 440.0f, 261.63f, inf,
+                                         0.0f, std::nanf(""), 880.0f, -inf, FLT_MAX, 55.0f, inf, std::nanf(""), -0.0f};
+    bool rejected = true;
+    std::vector<std::int32_t> expected;
+    for (auto [level, label] : LEVELS) {
+        // A tiny A4 makes FLT_MAX overflow the ratio to A4
+        FrequencyConverter converter(1e-3f, level);
+        if (converter.getSimdLevel() != level) continue;
+        std::vector<std::int32_t> notes(unusable.size());
+        std::vector<float> deviations(unusable.size());
+        converter.hzToMidi(unusable, notes, deviations);
+        for (std::size_t i = 0; i < unusable.size(); ++i) {
+            bool usable = std::isfinite(unusable[i]) && unusable[i] > 0.0f && unusable[i] < FLT_MAX;
+            rejected = rejected && (usable ? notes[i] != -1 : notes[i] == -1 && deviations[i] == 0.0f);
+        }
+        if (expected.empty()) expected = notes;
+        rejected = rejected && notes == expected;
+    }
+    std::cout << "Zero, negative, NaN, infinite and overflowing frequencies give -1 in every kernel: " << (rejected ? "ok" : "FAILED") << std::endl;
+    return rejected ? 0 : 1;
+}
@@ -0,0 +1,65 @@
+#include "bench.hpp"
+#include "harmony_analyzer.hpp"
+#include <random>
+
+int main() {
+    constexpr std::size_t sheetCount = 5'000;
+    constexpr std::size_t sectionCount = 4;
+    constexpr std::size_t sectionLength = 16;
+    constexpr std::size_t sheetLength = sectionCount * sectionLength;
+
+    // Lead sheets of four sections, each in a key a fifth or a relative away
+    // from the last, drawn from its diatonic triads and sevenths with the tonic
+    // and dominant favoured and the occasional secondary dominant
+    constexpr std::array<double, 7> DEGREE_WEIGHTS = {4, 2, 1, 2, 3, 2, 1};
+
+    std::mt19937 rng(42);
+    std::discrete_distribution<int> degree(DEGREE_WEIGHTS.begin(), DEGREE_WEIGHTS.end());
+    std::vector<Chord> chords;
+    std::vector<Key> keys;
+    chords.reserve(sheetCount * sheetLength);
+    keys.reserve(sheetCount * sheetLength);
+    for (std::size_t sheet = 0; sheet < sheetCount; ++sheet) {
+        Key key{rng() % 2 ? ScaleType::Minor : ScaleType::Major, static_cast<std::uint8_t>(rng() % 12)};
+        for (std::size_t section = 0; section < sectionCount; ++section) {
+            if (section > 0) {
+                switch (rng() % 3) {
+                    case 0: key.tonic = static_cast<std::uint8_t>((key.tonic + 7) % 12); break;
+                    case 1: key.tonic = static_cast<std::uint8_t>((key.tonic + 5) % 12); break;
+                    case 2:
+                        key.tonic = static_cast<std::uint8_t>((key.tonic + (key.isMinor() ? 3 : 9)) % 12);
+                        key.type = key.isMinor() ? ScaleType::Major : ScaleType::Minor;
+                        break;
+                }
+            }
+            Scale scale(key.type, Note(60 + key.tonic));
+            for (std::size_t i = 0; i < sectionLength; ++i) {
+                int d = i == 0 || i + 1 == sectionLength ? 0 : i + 2 == sectionLength ? 4 : degree(rng);
+                auto chord = rng() % 2 ? DiatonicHarmony::seventh(scale, d) : DiatonicHarmony::triad(scale, d);
+                if (key.isMinor() && d == 4) chord = Chord(ChordType::Dominant7, scale.getDegree(4));
+                if (rng() % 10 == 0 && d != 0 && d != 6) chord = Chord(ChordType::Dominant7, scale.getDegree(d).transpose(7));
+                chords.push_back(*chord);
+                keys.push_back(key);
+            }
+        }
+    }
+
+    std::cout << "Analyzing " << sheetCount << " lead sheets of " << sheetLength << " chords" << std::endl;
+
+    std::size_t correct = 0, modulations = 0;
+    runBenchmark("HarmonicAnalyzer::analyze (per chord)", chords.size(), [&] {
+        for (std::size_t sheet = 0; sheet < sheetCount; ++sheet) {
+            std::span<const Chord> tune(chords.data() + sheet * sheetLength, sheetLength);
+            HarmonicAnalysis analysis = HarmonicAnalyzer::analyze(tune);
+            for (std::size_t i = 0; i < sheetLength; ++i) correct += analysis.chords[i].key == keys[sheet * sheetLength + i];
+            modulations += analysis.modulations.size();
+            doNotOptimize(analysis);
+        }
+    });
+
+    std::cout << "Chords assigned the key they were written in: " << std::setprecision(1) << 100.0 * correct / chords.size() << "%"
+              << std::endl;
+    std::cout << "Modulations found per sheet: " << std::setprecision(2) << static_cast<double>(modulations) / sheetCount
+              << " (written: " << sectionCount - 1 << ")" << std::endl;
+    return 0;
+}
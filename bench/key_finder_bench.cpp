@@ -0,0 +1,50 @@
+#include "bench.hpp"
+#include "key_finder.hpp"
+#include <random>
+
+int main() {
+    constexpr std::size_t tuneCount = 20'000;
+    constexpr std::size_t tuneLength = 256;
+
+    // Melodies drawn from a key's diatonic scale, tonic triad tones twice as likely
+    constexpr std::array<int, 7> MAJOR = {0, 2, 4, 5, 7, 9, 11};
+    constexpr std::array<int, 7> MINOR = {0, 2, 3, 5, 7, 8, 10};
+    constexpr std::array<double, 7> DEGREE_WEIGHTS = {2, 1, 2, 1, 2, 1, 1};
+
+    std::mt19937 rng(42);
+    std::discrete_distribution<int> degree(DEGREE_WEIGHTS.begin(), DEGREE_WEIGHTS.end());
+    std::vector<Key> keys(tuneCount);
+    std::vector<std::uint8_t> notes(tuneCount * tuneLength);
+    for (std::size_t t = 0; t < tuneCount; ++t) {
+        bool minor = rng() % 2;
+        keys[t] = Key{minor ? ScaleType::Minor : ScaleType::Major, static_cast<std::uint8_t>(rng() % 12)};
+        for (std::size_t i = 0; i < tuneLength; ++i) {
+            int step = (minor ? MINOR : MAJOR)[degree(rng)];
+            notes[t * tuneLength + i] = static_cast<std::uint8_t>((keys[t].tonic + step) % 12);
+        }
+    }
+
+    std::cout << "Streaming " << tuneCount << " melodies of " << tuneLength << " notes through the key finder" << std::endl;
+
+    for (int p = 0; p < static_cast<int>(KeyProfile::Count); ++p) {
+        KeyProfile profile = static_cast<KeyProfile>(p);
+        std::size_t correct = 0;
+        std::string label = "KeyFinder::push + best (" + std::string(keyProfileName(profile)) + ")";
+        runBenchmark(label, tuneCount * tuneLength, [&] {
+            KeyFinder finder(profile);
+            for (std::size_t t = 0; t < tuneCount; ++t) {
+                finder.reset();
+                std::optional<KeyEstimate> estimate;
+                for (std::size_t i = 0; i < tuneLength; ++i) {
+                    finder.push(notes[t * tuneLength + i]);
+                    estimate = finder.best();
+                    doNotOptimize(estimate);
+                }
+                correct += estimate && estimate->key == keys[t];
+            }
+        });
+        std::cout << "  final key correct for " << std::setprecision(1) << 100.0 * correct / tuneCount << "% of melodies"
+                  << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,68 @@
+#include "bench.hpp"
+#include "progression.hpp"
+#include <random>
+
+int main() {
+    constexpr std::size_t progressionCount = 1'000'000;
+    constexpr std::size_t progressionLength = 8;
+    constexpr std::size_t rebuildCount = 10'000;
+
+    // Random worksheet progressions over the diatonic numerals of a major key
+    constexpr std::array<std::string_view, 10> NUMERALS = {
+        "I", "ii7", "iii", "IV", "V7", "vi", "viiø7", "V7/V", "bVII", "IVmaj7"
+    };
+
+    std::mt19937 rng(42);
+    std::vector<DegreeProgression> progressions;
+    std::vector<std::vector<RomanNumeral>> numerals(rebuildCount);
+    progressions.reserve(progressionCount);
+    for (std::size_t p = 0; p < progressionCount; ++p) {
+        std::array<RomanNumeral, progressionLength> line;
+        for (RomanNumeral& numeral : line) numeral = *RomanNumeralParser::parse(NUMERALS[rng() % NUMERALS.size()]);
+        progressions.push_back(DegreeProgression::fromRomanNumerals(ScaleType::Major, line));
+        if (p < rebuildCount) numerals[p].assign(line.begin(), line.end());
+    }
+
+    std::cout << "Re-keying " << progressionCount << " progressions of " << progressionLength << " chords into all 12 keys"
+              << std::endl;
+
+    std::vector<Chord> out(12 * progressionLength, Chord::major(Note(60)));
+    runBenchmark("DegreeProgression::realizeAllKeys", progressionCount, [&] {
+        for (const DegreeProgression& progression : progressions) {
+            progression.realizeAllKeys(out);
+            doNotOptimize(out);
+        }
+    });
+
+    // The old path: a Scale per key and every numeral realized again
+    runBenchmark("createFromRomanNumerals in 12 keys", rebuildCount, [&] {
+        for (const auto& line : numerals) {
+            for (int key = 0; key < 12; ++key) {
+                ChordProgression progression = ChordProgression::createFromRomanNumerals(Scale::majorScale(Note(60 + key)), line, "");
+                doNotOptimize(progression);
+            }
+        }
+    });
+
+    // Both paths must build the same chords. Spellings are compared in C only:
+    // elsewhere the rebuild spells a secondary dominant from its own target's
+    // key signature (Ab7 for V7/V in F#), re-keying from the home key's letters (G#7).
+    for (std::size_t p = 0; p < rebuildCount; ++p) {
+        progressions[p].realizeAllKeys(out);
+        for (int key = 0; key < 12; ++key) {
+            ChordProgression expected = ChordProgression::createFromRomanNumerals(Scale::majorScale(Note(60 + key)), numerals[p], "");
+            for (std::size_t i = 0; i < progressionLength; ++i) {
+                const Chord& want = expected.getChords()[i];
+                const Chord& got = out[key * progressionLength + i];
+                bool same = want.getType() == got.getType() && want.getRoot().getPitchClass() == got.getRoot().getPitchClass();
+                if (!same || (key == 0 && want.getName() != got.getName())) {
+                    std::cout << "Mismatch in progression " << p << " key " << key << ": " << want.getName() << " vs "
+                              << got.getName() << std::endl;
+                    return 1;
+                }
+            }
+        }
+    }
+    std::cout << "Checked " << rebuildCount << " progressions in all 12 keys against the rebuild" << std::endl;
+    return 0;
+}
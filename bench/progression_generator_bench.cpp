@@ -0,0 +1,60 @@
+#include "bench.hpp"
+#include "progression_generator.hpp"
+
+int main() {
+    constexpr std::size_t progressionCount = 5'000'000;
+    constexpr std::size_t progressionLength = 8;
+
+    auto corpus = ProgressionCorpus::get(ScaleType::Major);
+    for (std::size_t order = 1; order <= 3; ++order) {
+        ProgressionGenerator generator(ScaleType::Major, corpus, order);
+        std::cout << "Order " << order << ": " << generator.stateCount() << " states over "
+                  << generator.getVocabulary().size() << " chords" << std::endl;
+
+        std::mt19937_64 engine(42);
+        std::array<DegreeChord, progressionLength> out;
+        std::size_t tonics = 0;
+        runBenchmark("ProgressionGenerator::generateInto", progressionCount, [&] {
+            for (std::size_t i = 0; i < progressionCount; ++i) {
+                generator.generateInto(engine, out);
+                tonics += out.back().offset == 0;
+                doNotOptimize(out);
+            }
+        });
+        std::cout << "  ending on the tonic: " << std::setprecision(1) << 100.0 * tonics / progressionCount << "%" << std::endl;
+
+        // The same seed must give the same progressions
+        std::mt19937_64 first(7), second(7);
+        for (int i = 0; i < 1000; ++i) {
+            if (generator.generate(first, progressionLength).getChords().back() != generator.generate(second, progressionLength).getChords().back()) {
+                std::cout << "Seeded generation is not reproducible" << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    // Order-1 chords should follow the corpus's own chord frequencies:
+    // count how often each chord is emitted against how often it appears
+    ProgressionGenerator generator(ScaleType::Major, corpus, 1);
+    auto vocabulary = generator.getVocabulary();
+    std::vector<double> expected(vocabulary.size()), observed(vocabulary.size());
+    std::size_t corpusChords = 0;
+    for (const DegreeProgression& progression : corpus) {
+        for (const DegreeChord& chord : progression.getChords()) {
+            expected[std::find(vocabulary.begin(), vocabulary.end(), chord) - vocabulary.begin()] += 1;
+            ++corpusChords;
+        }
+    }
+    std::mt19937_64 engine(1);
+    constexpr std::size_t walk = 1'000'000;
+    DegreeProgression longWalk = generator.generate(engine, walk);
+    for (const DegreeChord& chord : longWalk.getChords()) {
+        observed[std::find(vocabulary.begin(), vocabulary.end(), chord) - vocabulary.begin()] += 1;
+    }
+    double worst = 0;
+    for (std::size_t i = 0; i < vocabulary.size(); ++i) {
+        worst = std::max(worst, std::abs(observed[i] / walk - expected[i] / corpusChords));
+    }
+    std::cout << "Largest gap between generated and corpus chord frequency: " << std::setprecision(4) << worst << std::endl;
+    return 0;
+}
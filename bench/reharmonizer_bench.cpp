@@ -0,0 +1,154 @@
+#include "bench.hpp"
+#include "reharmonizer.hpp"
+#include <random>
+
+int main() {
+    constexpr std::size_t tuneCount = 200;
+    constexpr std::size_t tuneLength = 64;
+
+    // Tunes in one key drawn from its diatonic sevenths, cadencing every eight bars
+    constexpr std::array<double, 7> DEGREE_WEIGHTS = {4, 3, 1, 2, 4, 2, 1};
+
+    std::mt19937 rng(7);
+    std::discrete_distribution<int> degree(DEGREE_WEIGHTS.begin(), DEGREE_WEIGHTS.end());
+    std::vector<std::vector<Chord>> tunes;
+    for (std::size_t tune = 0; tune < tuneCount; ++tune) {
+        Scale scale(ScaleType::Major, Note(60 + static_cast<int>(rng() % 12)));
+        std::vector<Chord> chords;
+        for (std::size_t i = 0; i < tuneLength; ++i) {
+            int d = i % 8 == 7 ? 0 : i % 8 == 6 ? 4 : degree(rng);
+            chords.push_back(*DiatonicHarmony::seventh(scale, d));
+        }
+        tunes.push_back(std::move(chords));
+    }
+
+    // No time limit, so every run searches the whole beam and runs can be compared
+    ReharmonizationOptions options;
+    options.beamWidth = 256;
+    options.timeLimit = std::chrono::hours(1);
+    unsigned hardwareThreads = std::thread::hardware_concurrency();
+    std::cout << "Reharmonizing " << tuneCount << " tunes of " << tuneLength << " chords, beam width " << options.beamWidth
+              << std::endl;
+
+    // A beam this narrow stays on the calling thread whatever the thread count
+    std::vector<std::vector<Reharmonization>> serial(tuneCount);
+    double serialRate = runBenchmark("Reharmonizer::search (per chord)", tuneCount * tuneLength, [&] {
+        for (std::size_t tune = 0; tune < tuneCount; ++tune) serial[tune] = Reharmonizer::instance().search(tunes[tune], {}, options);
+    });
+    std::cout << "Time per tune: " << std::setprecision(2) << 1e3 * tuneLength / serialRate << " ms" << std::endl;
+
+    // A wide beam is split across threads; at least four, so the barrier
+    // and the merge are exercised on small machines too
+    constexpr std::size_t wideCount = 4;
+    unsigned wideThreads = std::max(4u, hardwareThreads);
+    ReharmonizationOptions wide = options;
+    wide.beamWidth = 32768;
+    std::cout << "Reharmonizing " << wideCount << " tunes with beam width " << wide.beamWidth << std::endl;
+
+    std::vector<std::vector<Reharmonization>> wideSerial(wideCount), wideParallel(wideCount);
+    wide.threads = 1;
+    double wideSerialRate = runBenchmark("Reharmonizer::search, 1 thread (per chord)", wideCount * tuneLength, [&] {
+        for (std::size_t tune = 0; tune < wideCount; ++tune) wideSerial[tune] = Reharmonizer::instance().search(tunes[tune], {}, wide);
+    });
+    wide.threads = wideThreads;
+    double wideParallelRate = runBenchmark("Reharmonizer::search, " + std::to_string(wideThreads) + " threads (per chord)", wideCount * tuneLength, [&] {
+        for (std::size_t tune = 0; tune < wideCount; ++tune) wideParallel[tune] = Reharmonizer::instance().search(tunes[tune], {}, wide);
+    });
+    std::cout << "Speedup with " << wideThreads << " threads on " << hardwareThreads << " hardware threads: " << std::setprecision(2)
+              << wideParallelRate / wideSerialRate << "x" << std::endl;
+
+    std::size_t mismatches = 0;
+    for (std::size_t tune = 0; tune < wideCount; ++tune) {
+        const auto& a = wideSerial[tune];
+        const auto& b = wideParallel[tune];
+        bool same = a.size() == b.size();
+        for (std::size_t r = 0; same && r < a.size(); ++r) {
+            same = a[r].cost == b[r].cost && a[r].chords.size() == b[r].chords.size();
+            for (std::size_t i = 0; same && i < a[r].chords.size(); ++i) {
+                same = a[r].chords[i].chord.getName() == b[r].chords[i].chord.getName() &&
+                       a[r].chords[i].substitution == b[r].chords[i].substitution;
+            }
+        }
+        mismatches += !same;
+    }
+    std::cout << "Tunes whose results differ between 1 and " << wideThreads << " threads: " << mismatches << std::endl;
+
+    // Every chord change pays its full motion, so a slot split in two costs
+    // the sum of its real motions rather than half of them
+    std::vector<Chord> cadences = {Chord::major(Note(60)), Chord::dominant7(Note(67)), Chord::major(Note(60)),
+                                   Chord::major(Note(65)), Chord::dominant7(Note(67)), Chord::major(Note(60))};
+    std::size_t splitResults = 0, miscounted = 0;
+    for (const Reharmonization& result : Reharmonizer::instance().search(cadences, {}, ReharmonizationOptions{.topK = 512})) {
+        int motion = 0;
+        for (std::size_t i = 1; i < result.chords.size(); ++i) {
+            motion += Reharmonizer::instance().voiceMotion(result.chords[i - 1].chord, result.chords[i].chord);
+        }
+        splitResults += result.chords.size() > cadences.size();
+        miscounted += result.voiceLeading != motion || result.cost != 2 * motion;
+    }
+    bool splitsCharged = splitResults > 0 && miscounted == 0;
+    std::cout << "C G7 C F G7 C split segments charged their full motion: " << (splitsCharged ? "ok" : "FAILED") << std::endl;
+
+    // A secondary or backdoor dominant is followed by the chord it resolves
+    // to, and only the chords a substitution brings in carry its tag: a
+    // related ii never tags its dominant or repeats the ii before it
+    std::vector<Chord> turnaround = {Chord::major7(Note(60)), Chord::minor7(Note(69)), Chord::minor7(Note(62)), Chord::dominant7(Note(67))};
+    std::vector<std::pair<const std::vector<Chord>*, std::vector<Reharmonization>>> resolving;
+    resolving.emplace_back(&turnaround, Reharmonizer::instance().search(turnaround, {}, ReharmonizationOptions{.topK = 40}));
+    for (std::size_t tune = 0; tune < tuneCount; ++tune) resolving.emplace_back(&tunes[tune], serial[tune]);
+    std::size_t unresolved = 0, mistagged = 0;
+    for (const auto& [original, results] : resolving) {
+        for (const Reharmonization& result : results) {
+            for (std::size_t i = 0; i < result.chords.size(); ++i) {
+                const ReharmonizedChord& chord = result.chords[i];
+                bool endsSlot = i + 1 == result.chords.size() || result.chords[i + 1].slot != chord.slot;
+                bool dominant = chord.substitution == Substitution::SecondaryDominant || chord.substitution == Substitution::BackdoorTwoFive;
+                if (dominant && endsSlot) {
+                    unresolved += i + 1 == result.chords.size() ||
+                                  result.chords[i + 1].chord.getName() != (*original)[chord.slot + 1].getName();
+                }
+                if (chord.substitution == Substitution::RelatedTwo) {
+                    mistagged += chord.chord.getType() != ChordType::Minor7 ||
+                                 (i > 0 && result.chords[i - 1].chord.getName() == chord.chord.getName());
+                }
+            }
+        }
+    }
+    bool resolved = unresolved == 0 && mistagged == 0;
+    std::cout << "Secondary and backdoor dominants resolve, related ii tagged alone: " << (resolved ? "ok" : "FAILED") << std::endl;
+
+    // Substitutes are spelled from the degree they stand on: the tritone sub
+    // of G7 going to C is Db7, and the backdoor dominant of C is Bb7
+    std::vector<Chord> twoFiveOne = {Chord::minor7(Note(62)), Chord::dominant7(Note(67)), Chord::major7(Note(60))};
+    std::size_t spelledSubs = 0, misspelledSubs = 0;
+    for (const Reharmonization& result : Reharmonizer::instance().search(twoFiveOne, {}, ReharmonizationOptions{.topK = 64})) {
+        for (const ReharmonizedChord& chord : result.chords) {
+            std::string name = chord.chord.getName();
+            spelledSubs += name == "Db7" || name == "Bb7";
+            misspelledSubs += name == "C#7" || name == "A#7";
+        }
+    }
+    // A melody of the wrong length is ignored rather than read past its end
+    std::vector<PitchClassSet> shortMelody(1, PitchClassSet().with(0));
+    bool shortMelodyIgnored = Reharmonizer::instance().search(twoFiveOne, shortMelody).front().melody == 0;
+    // Charts past 255 slots count substitutions and slots without wrapping;
+    // a negative cost per substitution makes the best path change nearly every chord
+    std::vector<Chord> longChart;
+    for (std::size_t i = 0; i < 400; ++i) longChart.push_back(i % 2 ? Chord::major(Note(60)) : Chord::dominant7(Note(67)));
+    auto longResults = Reharmonizer::instance().search(longChart, {}, ReharmonizationOptions{.beamWidth = 16, .topK = 1, .substitutionCost = -20});
+    std::size_t changedSlots = 0;
+    for (std::size_t i = 0; i < longResults.front().chords.size(); ++i) {
+        const ReharmonizedChord& chord = longResults.front().chords[i];
+        bool counted = i > 0 && longResults.front().chords[i - 1].slot == chord.slot &&
+                       longResults.front().chords[i - 1].substitution != Substitution::Original;
+        changedSlots += !counted && chord.substitution != Substitution::Original;
+    }
+    bool longChartCounted = changedSlots > 255 && static_cast<std::size_t>(longResults.front().substitutions) == changedSlots &&
+                            longResults.front().chords.back().slot == longChart.size() - 1;
+    bool knownAnswers = splitsCharged && resolved && spelledSubs > 0 && misspelledSubs == 0 && shortMelodyIgnored && longChartCounted;
+    std::cout << "Dm7 G7 Cmaj7 substitutes spelled Db7 and Bb7, short melody ignored, 400-chord chart counted: " << (knownAnswers ? "ok" : "FAILED") << std::endl;
+
+    std::cout << "Best cost of the first tune: " << serial[0].front().cost << " with " << serial[0].front().substitutions
+              << " substitutions" << std::endl;
+    return mismatches == 0 && knownAnswers ? 0 : 1;
+}
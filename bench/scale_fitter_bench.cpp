@@ -0,0 +1,71 @@
+#include "bench.hpp"
+#include "scale_fitter.hpp"
+#include "catalog.hpp"
+#include <random>
+
+int main() {
+    constexpr std::size_t tuneCount = 2'000;
+    constexpr std::size_t tuneLength = 256;
+    constexpr std::size_t windowSize = 16;
+    constexpr std::size_t shown = 5;
+
+    // Melodies drawn from a major scale, tonic triad tones twice as likely
+    constexpr std::array<int, 7> MAJOR = {0, 2, 4, 5, 7, 9, 11};
+    constexpr std::array<double, 7> DEGREE_WEIGHTS = {2, 1, 2, 1, 2, 1, 1};
+
+    std::mt19937 rng(42);
+    std::discrete_distribution<int> degree(DEGREE_WEIGHTS.begin(), DEGREE_WEIGHTS.end());
+    std::vector<int> tonics(tuneCount);
+    std::vector<std::uint8_t> notes(tuneCount * tuneLength);
+    for (std::size_t t = 0; t < tuneCount; ++t) {
+        tonics[t] = static_cast<int>(rng() % 12);
+        for (std::size_t i = 0; i < tuneLength; ++i) {
+            notes[t * tuneLength + i] = static_cast<std::uint8_t>((tonics[t] + MAJOR[degree(rng)]) % 12);
+        }
+    }
+
+    std::cout << "Streaming " << tuneCount << " melodies of " << tuneLength << " notes through a " << windowSize
+              << "-note scale fitter" << std::endl;
+
+    ScaleFitter fitter(windowSize);
+    runBenchmark("ScaleFitter::push", tuneCount * tuneLength, [&] {
+        for (std::size_t t = 0; t < tuneCount; ++t) {
+            fitter.reset();
+            for (std::size_t i = 0; i < tuneLength; ++i) fitter.push(notes[t * tuneLength + i]);
+            doNotOptimize(fitter.getHistogram());
+        }
+    });
+
+    // Ranking after every note, as a live display would
+    std::array<ScaleFit, shown> fits{};
+    std::size_t correct = 0;
+    runBenchmark("ScaleFitter::push + bestInto", tuneCount * tuneLength, [&] {
+        for (std::size_t t = 0; t < tuneCount; ++t) {
+            fitter.reset();
+            for (std::size_t i = 0; i < tuneLength; ++i) {
+                fitter.push(notes[t * tuneLength + i]);
+                doNotOptimize(fitter.bestInto(fits));
+            }
+            PitchClassSet scale = PitchClassSet(FormulaCatalog::get(ScaleType::Major).mask).transpose(tonics[t]);
+            correct += fits[0].getPitchClassSet() == scale;
+        }
+    });
+    std::cout << "  best fit has the melody's notes for " << std::setprecision(1) << 100.0 * correct / tuneCount
+              << "% of melodies" << std::endl;
+
+    runBenchmark("ScaleFitter::push + best (allocating)", tuneCount * tuneLength, [&] {
+        for (std::size_t t = 0; t < tuneCount; ++t) {
+            fitter.reset();
+            for (std::size_t i = 0; i < tuneLength; ++i) {
+                fitter.push(notes[t * tuneLength + i]);
+                doNotOptimize(fitter.best(shown));
+            }
+        }
+    });
+
+    // The window is clamped so its 16-bit counters cannot wrap
+    ScaleFitter huge(std::size_t{1} << 20);
+    bool clamped = huge.capacity() == ScaleFitter::MAX_WINDOW;
+    std::cout << "Window clamped to " << ScaleFitter::MAX_WINDOW << " notes: " << (clamped ? "ok" : "FAILED") << std::endl;
+    return clamped ? 0 : 1;
+}
@@ -0,0 +1,73 @@
+#include "bench.hpp"
+#include "symbol_parser.hpp"
+#include <fstream>
+#include <random>
+#include <sstream>
+
+// Writes count random chord symbols, one per line, e.g. "C#m7b5/G"
+static void writeSymbolFile(const std::string& path, std::size_t count) {
+    constexpr std::array<std::string_view, 7> LETTERS = {"C", "D", "E", "F", "G", "A", "B"};
+    constexpr std::array<std::string_view, 5> ACCIDENTALS = {"", "", "#", "b", "bb"};
+
+    std::mt19937 rng(42);
+    std::ofstream out(path);
+    for (std::size_t i = 0; i < count; ++i) {
+        out << LETTERS[rng() % LETTERS.size()] << ACCIDENTALS[rng() % ACCIDENTALS.size()];
+        out << FormulaCatalog::CHORDS[rng() % FormulaCatalog::CHORDS.size()].symbol;
+        if (rng() % 4 == 0) {
+            out << '/' << LETTERS[rng() % LETTERS.size()] << ACCIDENTALS[rng() % ACCIDENTALS.size()];
+        }
+        out << '\n';
+    }
+}
+
+int main(int argc, char** argv) {
+    constexpr std::size_t symbolCount = 1'000'000;
+
+    std::string path = argc > 1 ? argv[1] : "build/chord_symbols.txt";
+    if (argc <= 1) {
+        writeSymbolFile(path, symbolCount);
+    }
+
+    std::ifstream in(path);
+    if (!in) {
+        std::cout << "Could not open " << path << std::endl;
+        return 1;
+    }
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    const std::string contents = buffer.str();
+
+    // Split once up front so the timed loop measures parsing only
+    std::vector<std::string_view> symbols;
+    std::string_view remaining = contents;
+    while (!remaining.empty()) {
+        std::size_t end = remaining.find('\n');
+        if (end == std::string_view::npos) end = remaining.size();
+        if (end > 0) symbols.push_back(remaining.substr(0, end));
+        remaining.remove_prefix(std::min(end + 1, remaining.size()));
+    }
+
+    std::cout << "Parsing " << symbols.size() << " chord symbols from " << path << std::endl;
+
+    std::size_t parsed = 0;
+    runBenchmark("SymbolParser::parseChord", symbols.size(), [&] {
+        for (auto symbol : symbols) {
+            auto chord = SymbolParser::parseChord(symbol);
+            parsed += chord.has_value();
+            doNotOptimize(chord);
+        }
+    });
+
+    std::size_t notes = 0;
+    runBenchmark("SymbolParser::parseNotePrefix", symbols.size(), [&] {
+        for (auto symbol : symbols) {
+            auto note = SymbolParser::parseNotePrefix(symbol);
+            notes += note.has_value();
+            doNotOptimize(note);
+        }
+    });
+
+    std::cout << parsed << " chords and " << notes << " roots parsed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,53 @@
+#include "bench.hpp"
+#include "note.hpp"
+
+// The string-carrying Note this project used before the compact value type,
+// kept here so the two can be compared side by side.
+class LegacyNote {
+    private:
+        std::string name;
+        int midiValue;
+
+    public:
+        LegacyNote() : name(""), midiValue(0) {}
+        LegacyNote(const std::string& noteName, int value) : name(noteName), midiValue(value) {}
+
+        std::string getName() const { return name; }
+        int getMidiValue() const { return midiValue; }
+
+        static const std::vector<std::string> ALL_NOTES;
+
+        LegacyNote transpose(int semitones) const {
+            int newMidiValue = midiValue + semitones;
+            int noteIndex = (newMidiValue % 12);
+            std::string newName = ALL_NOTES[noteIndex];
+            return LegacyNote(newName, newMidiValue);
+        }
+};
+
+const std::vector<std::string> LegacyNote::ALL_NOTES = {"C", "C#/Db", "D", "D#/Eb", "E", "F", "F#/Gb", "G", "G#/Ab", "A", "A#/Bb", "B"};
+
+int main() {
+    constexpr std::size_t iterations = 20'000'000;
+
+    std::cout << "Transposing " << iterations << " notes" << std::endl;
+
+    double before = runBenchmark("LegacyNote::transpose (std::string)", iterations, [&] {
+        LegacyNote note("C", 60);
+        for (std::size_t i = 0; i < iterations; ++i) {
+            note = note.transpose(i % 2 ? 7 : -7);
+            doNotOptimize(note);
+        }
+    });
+
+    double after = runBenchmark("Note::transpose (2-byte value)", iterations, [&] {
+        Note note(60);
+        for (std::size_t i = 0; i < iterations; ++i) {
+            note = note.transpose(i % 2 ? 7 : -7);
+            doNotOptimize(note);
+        }
+    });
+
+    std::cout << "Speedup: " << std::setprecision(1) << after / before << "x" << std::endl;
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include "bench.hpp"
+#include "tuning.hpp"
+#include <cmath>
+#include <random>
+
+// Quarter-comma meantone as published in the Scala archive (meanquar.scl)
+constexpr std::string_view MEANTONE_SCL =
+    "! meanquar.scl\n"
+    "!\n"
+    "1/4-comma meantone scale. Pietro Aaron's temperament (1523)\n"
+    " 12\n"
+    "!\n"
+    " 76.04900\n 193.15686\n 310.26471\n 386.31371\n 503.42157\n 579.47057\n"
+    " 696.57843\n 772.62743\n 889.73529\n 1006.84314\n 1082.89214\n 2/1\n";
+
+static bool near(double actual, double expected, double tolerance = 1e-6) {
+    return std::abs(actual - expected) <= tolerance;
+}
+
+int main() {
+    constexpr std::size_t lookupCount = 1 << 22;
+    constexpr int passes = 8;
+    constexpr double MIDDLE_C = 261.6255653005986;
+
+    Tuning edo12 = Tuning::equalDivision(12);
+    Tuning edo19 = Tuning::equalDivision(19);
+    Tuning edo24 = Tuning::equalDivision(24);
+    Tuning edo31 = Tuning::equalDivision(31);
+    auto meantone = Tuning::fromScala(MEANTONE_SCL);
+
+    // Known cents, frequencies and nearest steps
+    std::vector<std::pair<std::string_view, bool>> checks = {
+        {"12-EDO A4 is 440 Hz", near(edo12.getFrequency(9), 440.0, 1e-9)},
+        {"19-EDO fifth is 11 steps, 694.7 cents", edo19.stepsForSemitones(7) == 11 && near(edo19.getCents(11), 1200.0 * 11 / 19)},
+        {"24-EDO quarter tone is 50 cents", near(edo24.getCents(1), 50.0) && edo24.stepsForSemitones(-1) == -2},
+        {"31-EDO octave doubles the frequency", near(edo31.getFrequency(31), 2 * MIDDLE_C, 1e-9) &&
+                                                 near(edo31.getFrequency(-31), MIDDLE_C / 2, 1e-9)},
+        {"31-EDO step far outside the table", near(edo31.getFrequency(31 * 8), MIDDLE_C * 256, 1e-6)},
+        {"Scala file parses", meantone && meantone->getStepsPerPeriod() == 12 && near(meantone->getPeriodCents(), 1200.0)},
+        {"Meantone major third is 5/4", meantone && near(meantone->getFrequency(4), MIDDLE_C * 1.25, 1e-4)},
+        {"Meantone fifth is 696.58 cents", meantone && near(meantone->getCents(7), 696.57843) && near(meantone->getCents(-5), 696.57843 - 1200)},
+        {"Malformed Scala file is rejected", !Tuning::fromScala("no count\n") && !Tuning::fromScala("name\n 2\n 100.0\n x/y\n")},
+    };
+
+    // Catalog scales and chords mapped onto 31-EDO steps
+    auto major31 = TunedScale::fromScale(edo31, 0, FormulaCatalog::get(ScaleType::Major));
+    auto triad31 = TunedScale::fromChord(edo31, 0, FormulaCatalog::get(ChordType::Major));
+    constexpr std::array<int, 7> MAJOR_31 = {0, 5, 10, 13, 18, 23, 28};
+    bool majorMatches = major31.size() == MAJOR_31.size();
+    for (std::size_t i = 0; majorMatches && i < MAJOR_31.size(); ++i) majorMatches = major31.getStep(i) == MAJOR_31[i];
+    checks.push_back({"31-EDO major scale steps", majorMatches});
+    checks.push_back({"31-EDO major triad steps", triad31.size() == 3 && triad31.getStep(1) == 10 && triad31.getStep(2) == 18});
+    constexpr std::array<int, 7> MAJOR_19 = {3, 3, 2, 3, 3, 3, 2};
+    auto fromSteps = TunedScale::fromSteps(edo19, 19, MAJOR_19);
+    checks.push_back({"19-EDO scale from step sizes", fromSteps.size() == 7 && fromSteps.getStep(6) == 19 + 17 &&
+                                                          near(fromSteps.getFrequency(0), 2 * MIDDLE_C, 1e-9)});
+
+    bool allPassed = true;
+    for (const auto& [label, passed] : checks) {
+        std::cout << (passed ? "ok      " : "FAILED  ") << label << std::endl;
+        allPassed = allPassed && passed;
+    }
+
+    // Lookups against the same frequency computed from scratch each time
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> stepDistribution(-3 * 31, 3 * 31 - 1);
+    std::vector<int> steps(lookupCount);
+    std::vector<double> hz(lookupCount);
+    for (int& step : steps) step = stepDistribution(rng);
+
+    std::cout << "Looking up " << lookupCount << " 31-EDO frequencies x " << passes << " passes" << std::endl;
+
+    runBenchmark("std::exp2 per lookup", lookupCount * passes, [&] {
+        for (int pass = 0; pass < passes; ++pass) {
+            for (std::size_t i = 0; i < lookupCount; ++i) hz[i] = MIDDLE_C * std::exp2(steps[i] / 31.0);
+            doNotOptimize(hz.data());
+        }
+    });
+
+    double worst = 0;
+    runBenchmark("Tuning::getFrequency", lookupCount * passes, [&] {
+        for (int pass = 0; pass < passes; ++pass) {
+            for (std::size_t i = 0; i < lookupCount; ++i) hz[i] = edo31.getFrequency(steps[i]);
+            doNotOptimize(hz.data());
+        }
+    });
+    for (std::size_t i = 0; i < lookupCount; ++i) {
+        worst = std::max(worst, 1200.0 * std::abs(std::log2(hz[i] / (MIDDLE_C * std::exp2(steps[i] / 31.0)))));
+    }
+    std::cout << "  worst error " << std::setprecision(5) << worst << " cents" << std::endl;
+    return allPassed ? 0 : 1;
+}
@@ -0,0 +1,39 @@
+#include "bench.hpp"
+#include "voice_leading.hpp"
+#include <random>
+
+int main() {
+    constexpr std::size_t tuneLength = 200;
+    constexpr std::size_t tuneCount = 50;
+
+    // Random tunes over the triads and sevenths a lead sheet mostly uses
+    constexpr std::array<ChordType, 9> QUALITIES = {
+        ChordType::Major, ChordType::Minor, ChordType::Dominant7, ChordType::Major7, ChordType::Minor7,
+        ChordType::HalfDiminished7, ChordType::Diminished7, ChordType::Dominant9, ChordType::Sus4
+    };
+
+    std::mt19937 rng(42);
+    std::vector<std::vector<Chord>> tunes(tuneCount);
+    for (auto& tune : tunes) {
+        for (std::size_t i = 0; i < tuneLength; ++i) {
+            tune.push_back(Chord(QUALITIES[rng() % QUALITIES.size()], Note(60 + static_cast<int>(rng() % 12))));
+        }
+    }
+
+    std::cout << "Voice leading " << tuneCount << " tunes of " << tuneLength << " chords" << std::endl;
+
+    long motion = 0;
+    double tunesPerSecond = runBenchmark("VoiceLeadingSolver::solve (per tune)", tuneCount, [&] {
+        for (const auto& tune : tunes) {
+            VoiceLeading leading = VoiceLeadingSolver::solve(tune);
+            motion += leading.totalMotion;
+            doNotOptimize(leading);
+        }
+    });
+
+    std::cout << "Time per tune: " << std::setprecision(3) << 1e3 / tunesPerSecond << " ms ("
+              << std::setprecision(0) << tunesPerSecond * tuneLength << " chords/s)" << std::endl;
+    std::cout << "Average motion per chord change: " << std::setprecision(2) << static_cast<double>(motion) / (tuneCount * (tuneLength - 1))
+              << " semitones" << std::endl;
+    return 0;
+}
@@ -0,0 +1,24 @@
+#include "bench.hpp"
+#include "chord.hpp"
+
+int main() {
+    // The whole piano keyboard, with a span limit generous enough for spread voicings
+    constexpr VoicingOptions pianoRange{21, 108, 36};
+
+    std::size_t voicings = 0;
+    std::size_t notes = 0;
+    runBenchmark("Every voicing of every chord on every root", FormulaCatalog::CHORDS.size() * 12, [&] {
+        for (std::size_t type = 0; type < FormulaCatalog::CHORDS.size(); ++type) {
+            for (int root = 0; root < 12; ++root) {
+                for (const Voicing& voicing : Chord(static_cast<ChordType>(type), Note(60 + root)).voicings(pianoRange)) {
+                    ++voicings;
+                    notes += voicing.size();
+                    doNotOptimize(voicing);
+                }
+            }
+        }
+    });
+
+    std::cout << voicings << " voicings, " << notes << " notes" << std::endl;
+    return 0;
+}
@@ -0,0 +1,195 @@
+#pragma once
+
+#include "common.hpp"
+#include "inline_list.hpp"
+
+// Constexpr tables of the scale and chord formulas the app knows about.
+// Scale and Chord refer to an entry by id, so building one for any root is a
+// couple of integer operations and never touches the heap.
+
+enum class ScaleType : std::uint8_t {
+    Major,
+    Minor,
+    HarmonicMinor,
+    MelodicMinor,
+    PentatonicMajor,
+    PentatonicMinor,
+    Blues,
+    Count
+};
+
+enum class ChordType : std::uint8_t {
+    Major,
+    Minor,
+    Dominant7,
+    Major7,
+    Minor7,
+    Diminished,
+    Augmented,
+    HalfDiminished7,
+    Diminished7,
+    // Suspended and added-tone
+    Sus2,
+    Sus4,
+    Dominant7Sus4,
+    Power,
+    Add9,
+    MinorAdd9,
+    Major6,
+    Minor6,
+    SixNine,
+    MinorMajor7,
+    // Extended
+    Dominant9,
+    Major9,
+    Minor9,
+    Dominant11,
+    Minor11,
+    Dominant13,
+    Major13,
+    Minor13,
+    // Altered
+    Dominant7Flat5,
+    Dominant7Sharp5,
+    Dominant7Flat9,
+    Dominant7Sharp9,
+    Dominant7Sharp11,
+    Major7Sharp11,
+    Altered,
+    AugmentedMajor7,
+    Count
+};
+
+struct ScaleFormula {
+    std::string_view name;
+    IntervalList steps;     // Semitones between consecutive degrees, one per scale degree
+    std::uint16_t mask = 0; // Pitch classes relative to the root, bit 0 = root
+
+    constexpr std::span<const std::uint8_t> getSteps() const { return steps; }
+
+    static constexpr ScaleFormula make(std::string_view name, std::initializer_list<int> steps) {
+        ScaleFormula formula{name, {}, 1};
+        int position = 0;
+        for (int step : steps) {
+            formula.steps.push_back(static_cast<std::uint8_t>(step));
+            position += step;
+            formula.mask |= static_cast<std::uint16_t>(1u << (position % 12));
+        }
+        return formula;
+    }
+};
+
+struct ChordFormula {
+    std::string_view name;   // Long name, e.g. "Dominant 7"
+    std::string_view symbol; // Suffix after the root, e.g. "7"
+    IntervalList offsets;    // Semitones above the root for each tone but the root, ascending
+    std::uint16_t mask = 0;  // Pitch classes relative to the root, bit 0 = root
+
+    constexpr std::span<const std::uint8_t> getOffsets() const { return offsets; }
+
+    static constexpr ChordFormula make(std::string_view name, std::string_view symbol, std::initializer_list<int> offsets) {
+        ChordFormula formula{name, symbol, {}, 1};
+        for (int offset : offsets) {
+            formula.offsets.push_back(static_cast<std::uint8_t>(offset));
+            formula.mask |= static_cast<std::uint16_t>(1u << (offset % 12));
+        }
+        return formula;
+    }
+};
+
+class FormulaCatalog {
+    public:
+        static constexpr std::array<ScaleFormula, static_cast<std::size_t>(ScaleType::Count)> SCALES = {
+            ScaleFormula::make("Major", {2, 2, 1, 2, 2, 2, 1}),
+            ScaleFormula::make("Minor", {2, 1, 2, 2, 1, 2, 2}),
+            ScaleFormula::make("Harmonic Minor", {2, 1, 2, 2, 1, 3, 1}),
+            ScaleFormula::make("Melodic Minor", {2, 1, 2, 2, 2, 2, 1}),
+            ScaleFormula::make("Pentatonic Major", {2, 2, 3, 2, 3}),
+            ScaleFormula::make("Pentatonic Minor", {3, 2, 2, 3, 2}),
+            ScaleFormula::make("Blues", {3, 2, 1, 1, 3, 2}),
+        };
+
+        static constexpr std::array<ChordFormula, static_cast<std::size_t>(ChordType::Count)> CHORDS = {
+            ChordFormula::make("Major", "", {4, 7}),
+            ChordFormula::make("Minor", "m", {3, 7}),
+            ChordFormula::make("Dominant 7", "7", {4, 7, 10}),
+            ChordFormula::make("Major 7", "maj7", {4, 7, 11}),
+            ChordFormula::make("Minor 7", "m7", {3, 7, 10}),
+            ChordFormula::make("Diminished", "dim", {3, 6}),
+            ChordFormula::make("Augmented", "aug", {4, 8}),
+            ChordFormula::make("Half-Diminished 7", "m7b5", {3, 6, 10}),
+            ChordFormula::make("Diminished 7", "dim7", {3, 6, 9}),
+            ChordFormula::make("Suspended 2", "sus2", {2, 7}),
+            ChordFormula::make("Suspended 4", "sus4", {5, 7}),
+            ChordFormula::make("Dominant 7 Suspended 4", "7sus4", {5, 7, 10}),
+            ChordFormula::make("Power", "5", {7}),
+            ChordFormula::make("Added 9", "add9", {4, 7, 14}),
+            ChordFormula::make("Minor Added 9", "madd9", {3, 7, 14}),
+            ChordFormula::make("Major 6", "6", {4, 7, 9}),
+            ChordFormula::make("Minor 6", "m6", {3, 7, 9}),
+            ChordFormula::make("Six-Nine", "6/9", {4, 7, 9, 14}),
+            ChordFormula::make("Minor-Major 7", "mMaj7", {3, 7, 11}),
+            ChordFormula::make("Dominant 9", "9", {4, 7, 10, 14}),
+            ChordFormula::make("Major 9", "maj9", {4, 7, 11, 14}),
+            ChordFormula::make("Minor 9", "m9", {3, 7, 10, 14}),
+            ChordFormula::make("Dominant 11", "11", {4, 7, 10, 14, 17}),
+            ChordFormula::make("Minor 11", "m11", {3, 7, 10, 14, 17}),
+            // The 11th is left out of major-third 13th chords, as usually voiced
+            ChordFormula::make("Dominant 13", "13", {4, 7, 10, 14, 21}),
+            ChordFormula::make("Major 13", "maj13", {4, 7, 11, 14, 21}),
+            ChordFormula::make("Minor 13", "m13", {3, 7, 10, 14, 17, 21}),
+            ChordFormula::make("Dominant 7 Flat 5", "7b5", {4, 6, 10}),
+            ChordFormula::make("Dominant 7 Sharp 5", "7#5", {4, 8, 10}),
+            ChordFormula::make("Dominant 7 Flat 9", "7b9", {4, 7, 10, 13}),
+            ChordFormula::make("Dominant 7 Sharp 9", "7#9", {4, 7, 10, 15}),
+            ChordFormula::make("Dominant 7 Sharp 11", "7#11", {4, 7, 10, 18}),
+            ChordFormula::make("Major 7 Sharp 11", "maj7#11", {4, 7, 11, 18}),
+            ChordFormula::make("Altered Dominant", "7alt", {4, 10, 13, 15, 18, 20}),
+            ChordFormula::make("Augmented Major 7", "maj7#5", {4, 8, 11}),
+        };
+
+        static constexpr const ScaleFormula& get(ScaleType type) { return SCALES[static_cast<std::size_t>(type)]; }
+        static constexpr const ChordFormula& get(ChordType type) { return CHORDS[static_cast<std::size_t>(type)]; }
+        
+        // The chord quality written with exactly this suffix, e.g. "m7b5"
+        static constexpr std::optional<ChordType> findChord(std::string_view symbol) {
+            for (std::size_t i = 0; i < CHORDS.size(); ++i) {
+                if (CHORDS[i].symbol == symbol) return static_cast<ChordType>(i);
+            }
+            return std::nullopt;
+        }
+};
+
+// Every table entry is built during constant evaluation; these fail to
+// compile if any formula stops being a constant expression or goes wrong.
+static_assert(FormulaCatalog::get(ScaleType::Major).mask == 0b101010110101);
+static_assert(FormulaCatalog::get(ScaleType::Minor).mask == 0b010110101101);
+static_assert(FormulaCatalog::get(ScaleType::Blues).steps.size() == 6);
+static_assert(FormulaCatalog::get(ChordType::Dominant7).mask == 0b010010010001);
+static_assert(FormulaCatalog::get(ChordType::HalfDiminished7).symbol == "m7b5");
+static_assert(FormulaCatalog::get(ChordType::Dominant13).mask == 0b011010010101);
+static_assert(FormulaCatalog::findChord("6/9") == ChordType::SixNine);
+static_assert([] {
+    for (const auto& scale : FormulaCatalog::SCALES) {
+        int octave = 0;
+        for (auto step : scale.getSteps()) octave += step;
+        if (octave != 12) return false;
+    }
+    return true;
+}(), "every scale formula must span exactly one octave");
+static_assert([] {
+    for (const auto& chord : FormulaCatalog::CHORDS) {
+        for (std::size_t i = 1; i < chord.offsets.size(); ++i) {
+            if (chord.offsets[i] <= chord.offsets[i - 1]) return false;
+        }
+    }
+    return true;
+}(), "chord offsets must be strictly ascending");
+static_assert([] {
+    for (std::size_t i = 0; i < FormulaCatalog::CHORDS.size(); ++i) {
+        for (std::size_t j = 0; j < i; ++j) {
+            if (FormulaCatalog::CHORDS[i].symbol == FormulaCatalog::CHORDS[j].symbol) return false;
+        }
+    }
+    return true;
+}(), "chord symbols must be unique");
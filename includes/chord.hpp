@@ -0,0 +1,112 @@
+#pragma once
+
+#include "common.hpp"
+#include "note.hpp"
+#include "pitch_class_set.hpp"
+#include "catalog.hpp"
+#include "spelling.hpp"
+#include "voicing.hpp"
+
+class Chord {
+    private:
+        ChordType type;
+        Note rootNote;
+        SpelledPitch rootSpelling;
+        
+        // Without a key, a chord is spelled as the tonic of its own major or minor key
+        static constexpr SpelledPitch defaultRootSpelling(ChordType chordType, const Note& root) {
+            std::uint16_t mask = FormulaCatalog::get(chordType).mask;
+            bool minor = (mask & (1u << 3)) && !(mask & (1u << 4));
+            Key key{minor ? ScaleType::Minor : ScaleType::Major, static_cast<std::uint8_t>(root.getPitchClass())};
+            return Speller::tonic(key);
+        }
+
+    public:
+        constexpr Chord(ChordType chordType, const Note& root)
+            : type(chordType), rootNote(root), rootSpelling(defaultRootSpelling(chordType, root)) {}
+        
+        constexpr Chord(ChordType chordType, const Note& root, SpelledPitch spelling)
+            : type(chordType), rootNote(root), rootSpelling(spelling) {}
+        
+        constexpr ChordType getType() const { return type; }
+        constexpr Note getRoot() const { return rootNote; }
+        constexpr const ChordFormula& getFormula() const { return FormulaCatalog::get(type); }
+        
+        // Semitones above the root, viewed straight out of the catalog
+        constexpr std::span<const std::uint8_t> getIntervals() const { return getFormula().getOffsets(); }
+        
+        constexpr SpelledPitch getRootSpelling() const { return rootSpelling; }
+        
+        // The same chord with its root spelled as it would be in the given key
+        constexpr Chord spelledIn(const Key& key) const {
+            return Chord(type, rootNote, Speller::spell(key, rootNote.getPitchClass()));
+        }
+        
+        // The same chord with its root spelled as given, e.g. A# rather than Bb
+        constexpr Chord spelledAs(SpelledPitch spelling) const {
+            return Chord(type, rootNote, spelling);
+        }
+        
+        // Spelling of the chord tone a given number of semitones above the root
+        constexpr SpelledPitch spellTone(int offset) const {
+            return offset == 0 ? rootSpelling : Speller::spellChordTone(rootSpelling, offset, getFormula().mask);
+        }
+        
+        // Spelling of a chord tone given by pitch class, e.g. D# rather than Eb for the #9 of C7#9
+        constexpr SpelledPitch spellPitchClass(int pitchClass) const {
+            int offset = ((pitchClass - rootNote.getPitchClass()) % 12 + 12) % 12;
+            for (auto interval : getIntervals()) {
+                if (interval % 12 == offset) return spellTone(interval);
+            }
+            return spellTone(offset);
+        }
+        
+        std::string getName() const {
+            return std::string(rootSpelling.getName()) + std::string(getFormula().symbol);
+        }
+        
+        // Root-position close voicing starting at the root note, held inline
+        constexpr InlineList<Note, 12> getNotes() const {
+            InlineList<Note, 12> notes;
+            notes.push_back(rootNote);
+            
+            for (auto interval : getIntervals()) {
+                notes.push_back(rootNote.transpose(interval));
+            }
+            
+            return notes;
+        }
+        
+        // Close, open, drop and spread voicings of this chord within a register
+        constexpr VoicingRange voicings(VoicingOptions options = {}) const {
+            return VoicingRange(type, rootNote.getPitchClass(), options);
+        }
+        
+        constexpr PitchClassSet getPitchClassSet() const {
+            return PitchClassSet(getFormula().mask).transpose(rootNote.getPitchClass());
+        }
+        
+        void print() const {
+            std::cout << getName() << " Chord: " << rootSpelling.getName() << " ";
+            for (auto interval : getIntervals()) {
+                std::cout << spellTone(interval).getName() << " ";
+            }
+            std::cout << std::endl;
+        }
+        
+        static constexpr Chord major(const Note& root) { return Chord(ChordType::Major, root); }
+        static constexpr Chord minor(const Note& root) { return Chord(ChordType::Minor, root); }
+        static constexpr Chord dominant7(const Note& root) { return Chord(ChordType::Dominant7, root); }
+        static constexpr Chord major7(const Note& root) { return Chord(ChordType::Major7, root); }
+        static constexpr Chord minor7(const Note& root) { return Chord(ChordType::Minor7, root); }
+        static constexpr Chord diminished(const Note& root) { return Chord(ChordType::Diminished, root); }
+        static constexpr Chord augmented(const Note& root) { return Chord(ChordType::Augmented, root); }
+        static constexpr Chord halfDiminished7(const Note& root) { return Chord(ChordType::HalfDiminished7, root); }
+        static constexpr Chord diminished7(const Note& root) { return Chord(ChordType::Diminished7, root); }
+};
+
+static_assert(std::is_trivially_copyable_v<Chord>);
+static_assert(sizeof(Chord) <= 8, "Chord must stay a small value so progressions are one flat array");
+static_assert(Chord::dominant7(Note(67)).getNotes().back() == Note(77));
+static_assert(Chord::dominant7(Note(70)).spellTone(10).getName() == "Ab");
+static_assert(Chord::dominant7(Note(67)).getPitchClassSet() == PitchClassSet::fromPitchClasses({7, 11, 2, 5}));
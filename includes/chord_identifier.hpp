@@ -0,0 +1,139 @@
+#pragma once
+
+#include "common.hpp"
+#include "pitch_class_set.hpp"
+#include "catalog.hpp"
+#include "chord.hpp"
+
+// How the lowest note relates to an identified chord
+enum class BassRole : std::uint8_t {
+    Root,      // Root position
+    ChordTone, // An inversion, written as a slash chord such as C/E
+    Added      // A bass note outside the chord, such as D/C
+};
+
+struct ChordMatch {
+    ChordType type = ChordType::Major;
+    std::uint8_t root = 0; // Pitch class of the chord root
+    std::uint8_t bass = 0; // Pitch class of the lowest note
+    BassRole bassRole = BassRole::Root;
+    bool omitsFifth = false;
+
+    constexpr Chord getChord() const { return Chord(type, Note(60 + root)); }
+
+    // A chord-tone bass is spelled as the chord spells that tone (D# for the
+    // #9 of C7#9); any other bass from the chord root's own key
+    constexpr SpelledPitch getBassSpelling() const {
+        Chord chord = getChord();
+        if (bassRole != BassRole::Added) return chord.spellPitchClass(bass);
+        std::uint16_t mask = chord.getFormula().mask;
+        bool minor = (mask & (1u << 3)) && !(mask & (1u << 4));
+        return Speller::spell(Key{minor ? ScaleType::Minor : ScaleType::Major, root}, bass);
+    }
+
+    // e.g. "C7(no5)", "Am7/C" or "D/C"
+    std::string getName() const {
+        std::string name = getChord().getName();
+        if (omitsFifth) name += "(no5)";
+        if (bassRole != BassRole::Root) {
+            name += "/";
+            name += getBassSpelling().getName();
+        }
+        return name;
+    }
+};
+
+// Reverse lookup from a sounding pitch-class set and its bass note to every
+// chord it can be read as: each catalog chord on each root, with and without
+// its perfect fifth, over each possible bass. Results for all 4096 x 12
+// (set, bass) pairs are ranked once up front, so identify() is two array reads.
+class ChordIdentifier {
+    private:
+        std::vector<std::uint32_t> offsets; // Results for key k are matches[offsets[k] .. offsets[k + 1])
+        std::vector<ChordMatch> matches;
+
+        static constexpr std::size_t key(PitchClassSet notes, int bass) {
+            return static_cast<std::size_t>(notes.getMask()) * 12 + static_cast<std::size_t>(bass);
+        }
+
+        // Calls fn(match, mask) for every reading of every catalog chord
+        template <typename Fn>
+        static void forEachReading(Fn&& fn) {
+            for (std::size_t t = 0; t < FormulaCatalog::CHORDS.size(); ++t) {
+                PitchClassSet formula(FormulaCatalog::CHORDS[t].mask);
+                // Only drop a perfect fifth when at least three other tones remain
+                bool canOmitFifth = formula.contains(7) && formula.size() >= 4;
+                for (int omit = 0; omit <= (canOmitFifth ? 1 : 0); ++omit) {
+                    PitchClassSet shape = omit ? formula.without(7) : formula;
+                    for (int root = 0; root < 12; ++root) {
+                        PitchClassSet chord = shape.transpose(root);
+                        for (int bass = 0; bass < 12; ++bass) {
+                            // A bass on the dropped fifth puts it straight back: that is the complete chord
+                            if (omit && bass == (root + 7) % 12) continue;
+                            ChordMatch match;
+                            match.type = static_cast<ChordType>(t);
+                            match.root = static_cast<std::uint8_t>(root);
+                            match.bass = static_cast<std::uint8_t>(bass);
+                            match.omitsFifth = omit != 0;
+                            match.bassRole = bass == root ? BassRole::Root : chord.contains(bass) ? BassRole::ChordTone : BassRole::Added;
+                            fn(match, chord.with(bass));
+                        }
+                    }
+                }
+            }
+        }
+
+        // Root position before inversions before added basses, complete
+        // chords before ones missing the fifth, then catalog order and root
+        static bool ranksBefore(const ChordMatch& a, const ChordMatch& b) {
+            if (a.bassRole != b.bassRole) return a.bassRole < b.bassRole;
+            if (a.omitsFifth != b.omitsFifth) return !a.omitsFifth;
+            if (a.type != b.type) return a.type < b.type;
+            return a.root < b.root;
+        }
+
+        ChordIdentifier() : offsets(4096 * 12 + 1, 0) {
+            // Count, prefix-sum, then fill, as in ScaleFinder
+            forEachReading([&](const ChordMatch& match, PitchClassSet mask) { ++offsets[key(mask, match.bass) + 1]; });
+            for (std::size_t i = 1; i < offsets.size(); ++i) {
+                offsets[i] += offsets[i - 1];
+            }
+
+            matches.resize(offsets.back());
+            std::vector<std::uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+            forEachReading([&](const ChordMatch& match, PitchClassSet mask) { matches[cursor[key(mask, match.bass)]++] = match; });
+
+            for (std::size_t k = 0; k + 1 < offsets.size(); ++k) {
+                std::sort(matches.begin() + offsets[k], matches.begin() + offsets[k + 1], ranksBefore);
+            }
+        }
+
+    public:
+        static const ChordIdentifier& instance() {
+            static const ChordIdentifier identifier;
+            return identifier;
+        }
+
+        // All readings of notes with bass as the lowest note, best first.
+        // Empty if bass is not one of the notes or nothing matches.
+        std::span<const ChordMatch> identify(PitchClassSet notes, int bass) const {
+            bass = ((bass % 12) + 12) % 12;
+            std::size_t k = key(notes, bass);
+            return std::span<const ChordMatch>(matches.data() + offsets[k], offsets[k + 1] - offsets[k]);
+        }
+
+        // Same, taking the bass from the lowest of the given notes
+        std::span<const ChordMatch> identify(std::span<const Note> notes) const {
+            if (notes.empty()) return {};
+            PitchClassSet set;
+            Note lowest = notes[0];
+            for (const Note& note : notes) {
+                set = set.with(note.getPitchClass());
+                if (note.getMidiValue() < lowest.getMidiValue()) lowest = note;
+            }
+            return identify(set, lowest.getPitchClass());
+        }
+};
+
+static_assert(ChordMatch{ChordType::Dominant7Sharp9, 0, 3, BassRole::ChordTone}.getBassSpelling().getName() == "D#");
+static_assert(ChordMatch{ChordType::Minor7, 9, 0, BassRole::ChordTone}.getBassSpelling().getName() == "C");
@@ -3,9 +3,17 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <array>
+#include <cstdint>
+#include <type_traits>
 #include <map>
 #include <algorithm>
 #include <functional>
 #include <memory>
 #include <iomanip>
-#include <limits>
\ No newline at end of file
+#include <limits>
+#include <bit>
+#include <initializer_list>
+#include <span>
+#include <optional>
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "common.hpp"
+#include "catalog.hpp"
+#include "scale_catalog.hpp"
+#include "scale.hpp"
+#include "chord.hpp"
+
+// The chords built by stacking alternate degrees of a scale on one of its
+// degrees. Either quality is nullopt when the stacked notes are not a chord
+// in the catalog, as happens on most degrees of the pentatonic scales.
+struct DiatonicChord {
+    std::optional<ChordType> triad;
+    std::optional<ChordType> seventh;
+};
+
+// Diatonic triads and sevenths on every degree of every ScaleType and of
+// every named scale in ScaleCatalog, worked out once during constant
+// evaluation. Qualities do not depend on the key, so one row per scale
+// serves all twelve roots.
+struct DiatonicTable {
+    static constexpr std::size_t MAX_DEGREES = 12;
+
+    using Row = std::array<DiatonicChord, MAX_DEGREES>;
+    using Positions = std::array<int, 2 * MAX_DEGREES + 1>; // Semitones from the scale root to each degree over two octaves
+
+    std::array<Row, static_cast<std::size_t>(ScaleType::Count)> chords{};
+    std::array<Row, ScaleCatalog::NAMES.size()> named{}; // By index into ScaleCatalog::NAMES
+
+    // The chord type with exactly these tones, if the catalog has one
+    static constexpr std::optional<ChordType> chordWithMask(std::uint16_t mask, std::size_t toneCount) {
+        for (std::size_t i = 0; i < FormulaCatalog::CHORDS.size(); ++i) {
+            const ChordFormula& formula = FormulaCatalog::CHORDS[i];
+            if (formula.mask == mask && formula.offsets.size() + 1 == toneCount) return static_cast<ChordType>(i);
+        }
+        return std::nullopt;
+    }
+
+    // Stacks alternate degrees on each of the scale's size degrees
+    static constexpr void stack(Row& row, const Positions& positions, std::size_t size) {
+        for (std::size_t degree = 0; degree < size; ++degree) {
+            std::uint16_t mask = 1;
+            for (std::size_t third = 1; third <= 3; ++third) {
+                int offset = positions[degree + 2 * third] - positions[degree];
+                mask |= static_cast<std::uint16_t>(1u << (offset % 12));
+                if (third == 2) row[degree].triad = chordWithMask(mask, 3);
+                if (third == 3) row[degree].seventh = chordWithMask(mask, 4);
+            }
+        }
+    }
+
+    constexpr DiatonicTable() {
+        for (std::size_t type = 0; type < FormulaCatalog::SCALES.size(); ++type) {
+            const IntervalList& steps = FormulaCatalog::SCALES[type].steps;
+            std::size_t size = steps.size();
+            Positions positions{};
+            for (std::size_t i = 1; i <= 2 * size; ++i) positions[i] = positions[i - 1] + steps[(i - 1) % size];
+            stack(chords[type], positions, size);
+        }
+
+        for (std::size_t i = 0; i < ScaleCatalog::NAMES.size(); ++i) {
+            PitchClassSet shape(ScaleCatalog::NAMES[i].mask);
+            std::array<int, MAX_DEGREES> members{};
+            std::size_t size = 0;
+            shape.forEach([&](int pc) { members[size++] = pc; });
+            Positions positions{};
+            for (std::size_t k = 0; k <= 2 * size; ++k) positions[k] = members[k % size] + 12 * static_cast<int>(k / size);
+            stack(named[i], positions, size);
+        }
+    }
+};
+
+class DiatonicHarmony {
+    private:
+        static constexpr DiatonicTable TABLE{};
+
+    public:
+        static constexpr const DiatonicChord& get(ScaleType type, int degree) {
+            return TABLE.chords[static_cast<std::size_t>(type)][static_cast<std::size_t>(degree)];
+        }
+
+        // The same for a named scale of ScaleCatalog, by its index into NAMES
+        static constexpr const DiatonicChord& getNamed(std::size_t nameIndex, int degree) {
+            return TABLE.named[nameIndex][static_cast<std::size_t>(degree)];
+        }
+
+        // The same for a scale shape rooted on pitch class 0; nullopt if the
+        // catalog has no name for it
+        static constexpr std::optional<DiatonicChord> get(PitchClassSet shape, int degree) {
+            std::int16_t nameIndex = ScaleCatalog::get(shape).nameIndex;
+            if (nameIndex < 0 || degree < 0 || degree >= shape.size()) return std::nullopt;
+            return getNamed(static_cast<std::size_t>(nameIndex), degree);
+        }
+
+        // The triad on a 0-based degree of the scale, spelled in its key
+        static constexpr std::optional<Chord> triad(const Scale& scale, int degree) {
+            auto type = get(scale.getType(), degree).triad;
+            if (!type) return std::nullopt;
+            return Chord(*type, scale.getDegree(degree)).spelledIn(scale.getKey());
+        }
+
+        // The seventh chord on a 0-based degree of the scale, spelled in its key
+        static constexpr std::optional<Chord> seventh(const Scale& scale, int degree) {
+            auto type = get(scale.getType(), degree).seventh;
+            if (!type) return std::nullopt;
+            return Chord(*type, scale.getDegree(degree)).spelledIn(scale.getKey());
+        }
+};
+
+static_assert(DiatonicHarmony::get(ScaleType::Major, 6).triad == ChordType::Diminished);
+static_assert(DiatonicHarmony::get(ScaleType::Major, 6).seventh == ChordType::HalfDiminished7);
+static_assert(DiatonicHarmony::get(ScaleType::Major, 4).seventh == ChordType::Dominant7);
+static_assert(DiatonicHarmony::get(ScaleType::HarmonicMinor, 6).seventh == ChordType::Diminished7);
+static_assert(DiatonicHarmony::get(ScaleType::HarmonicMinor, 2).seventh == ChordType::AugmentedMajor7);
+static_assert(DiatonicHarmony::get(ScaleType::MelodicMinor, 0).seventh == ChordType::MinorMajor7);
+static_assert(DiatonicHarmony::get(*ScaleCatalog::find("Dorian"), 3)->seventh == ChordType::Dominant7);
+static_assert(DiatonicHarmony::get(*ScaleCatalog::find("Lydian Dominant"), 0)->seventh == ChordType::Dominant7);
+static_assert(DiatonicHarmony::get(*ScaleCatalog::find("Whole Tone"), 4)->triad == ChordType::Augmented);
+static_assert(DiatonicHarmony::get(*ScaleCatalog::find("Altered"), 0)->seventh == ChordType::HalfDiminished7);
@@ -0,0 +1,263 @@
+#pragma once
+
+#include "common.hpp"
+#include "note.hpp"
+#include <cfloat>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define MUSIC_THEORY_X86 1
+#endif
+
+enum class SimdLevel : std::uint8_t {
+    Scalar,
+    SSE2,
+    AVX2
+};
+
+// Batch conversion between MIDI pitch and frequency in Hz around a
+// configurable A4. Spans are processed with AVX2 or SSE2 kernels when the CPU
+// has them, falling back to a plain scalar loop elsewhere. The vector paths
+// use polynomial exp2/log approximations accurate to well under 0.01 cents.
+class FrequencyConverter {
+    private:
+        float referenceA4;
+        SimdLevel level;
+
+        static constexpr float SEMITONES_PER_NATURAL_LOG = 17.312340490667562f; // 12 / ln(2)
+
+        static void midiToHzScalar(const float* midi, const float* cents, float* hz, std::size_t count, float a4) {
+            for (std::size_t i = 0; i < count; ++i) {
+                float pitch = midi[i] + (cents ? cents[i] * 0.01f : 0.0f);
+                hz[i] = a4 * std::exp2((pitch - 69.0f) * (1.0f / 12.0f));
+            }
+        }
+
+        // Every kernel rejects the same inputs; see hzToMidi
+        static void hzToMidiScalar(const float* hz, std::int32_t* nearest, float* cents, std::size_t count, float a4) {
+            const float inverseReference = 1.0f / a4;
+            for (std::size_t i = 0; i < count; ++i) {
+                float ratio = hz[i] * inverseReference;
+                if (!std::isfinite(hz[i]) || hz[i] <= 0.0f || !std::isnormal(ratio)) {
+                    nearest[i] = -1;
+                    cents[i] = 0.0f;
+                    continue;
+                }
+                float pitch = 69.0f + 12.0f * std::log2(ratio);
+                float rounded = std::nearbyint(pitch);
+                nearest[i] = static_cast<std::int32_t>(rounded);
+                cents[i] = (pitch - rounded) * 100.0f;
+            }
+        }
+
+#ifdef MUSIC_THEORY_X86
+        // 2^x for |x| < 126: split x into integer and fractional parts, evaluate a
+        // Cephes minimax polynomial on the fraction and add the integer part
+        // straight into the exponent bits.
+        static __m128 exp2Sse(__m128 x) {
+            __m128i whole = _mm_cvtps_epi32(x);
+            __m128 f = _mm_sub_ps(x, _mm_cvtepi32_ps(whole));
+            __m128 p = _mm_set1_ps(1.535336188319500e-4f);
+            p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(1.339887440266574e-3f));
+            p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(9.618437357674640e-3f));
+            p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(5.550332471162809e-2f));
+            p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(2.402264791363012e-1f));
+            p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(6.931472028550421e-1f));
+            p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(1.0f));
+            __m128i scale = _mm_slli_epi32(_mm_add_epi32(whole, _mm_set1_epi32(127)), 23);
+            return _mm_mul_ps(p, _mm_castsi128_ps(scale));
+        }
+
+        // Natural log for positive normal x, after Cephes logf
+        static __m128 logSse(__m128 x) {
+            __m128i bits = _mm_castps_si128(x);
+            __m128 exponent = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(126)));
+            __m128 m = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F000000)));
+
+            // Fold the mantissa from [0.5, 1) into [sqrt(0.5), sqrt(2)) - 1
+            __m128 small = _mm_cmplt_ps(m, _mm_set1_ps(0.707106781186547524f));
+            exponent = _mm_sub_ps(exponent, _mm_and_ps(small, _mm_set1_ps(1.0f)));
+            m = _mm_add_ps(_mm_sub_ps(m, _mm_set1_ps(1.0f)), _mm_and_ps(small, m));
+
+            __m128 z = _mm_mul_ps(m, m);
+            __m128 y = _mm_set1_ps(7.0376836292e-2f);
+            y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(-1.1514610310e-1f));
+            y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(1.1676998740e-1f));
+            y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(-1.2420140846e-1f));
+            y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(1.4249322787e-1f));
+            y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(-1.6668057665e-1f));
+            y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(2.0000714765e-1f));
+            y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(-2.4999993993e-1f));
+            y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(3.3333331174e-1f));
+            y = _mm_mul_ps(_mm_mul_ps(y, m), z);
+            y = _mm_add_ps(y, _mm_mul_ps(exponent, _mm_set1_ps(-2.12194440e-4f)));
+            y = _mm_sub_ps(y, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+            return _mm_add_ps(_mm_add_ps(m, y), _mm_mul_ps(exponent, _mm_set1_ps(0.693359375f)));
+        }
+
+        static void midiToHzSse(const float* midi, const float* cents, float* hz, std::size_t count, float a4) {
+            const __m128 reference = _mm_set1_ps(a4);
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                __m128 pitch = _mm_loadu_ps(midi + i);
+                if (cents) pitch = _mm_add_ps(pitch, _mm_mul_ps(_mm_loadu_ps(cents + i), _mm_set1_ps(0.01f)));
+                __m128 octaves = _mm_mul_ps(_mm_sub_ps(pitch, _mm_set1_ps(69.0f)), _mm_set1_ps(1.0f / 12.0f));
+                _mm_storeu_ps(hz + i, _mm_mul_ps(reference, exp2Sse(octaves)));
+            }
+            midiToHzScalar(midi + i, cents ? cents + i : nullptr, hz + i, count - i, a4);
+        }
+
+        static void hzToMidiSse(const float* hz, std::int32_t* nearest, float* cents, std::size_t count, float a4) {
+            const __m128 inverseReference = _mm_set1_ps(1.0f / a4);
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                __m128 input = _mm_loadu_ps(hz + i);
+                __m128 ratio = _mm_mul_ps(input, inverseReference);
+                // Ordered compares, so NaN lanes are invalid too
+                __m128 valid = _mm_and_ps(_mm_and_ps(_mm_cmpgt_ps(input, _mm_setzero_ps()), _mm_cmple_ps(input, _mm_set1_ps(FLT_MAX))),
+                                          _mm_and_ps(_mm_cmpge_ps(ratio, _mm_set1_ps(FLT_MIN)), _mm_cmple_ps(ratio, _mm_set1_ps(FLT_MAX))));
+                ratio = _mm_or_ps(_mm_and_ps(valid, ratio), _mm_andnot_ps(valid, _mm_set1_ps(1.0f)));
+                __m128 pitch = _mm_add_ps(_mm_set1_ps(69.0f), _mm_mul_ps(logSse(ratio), _mm_set1_ps(SEMITONES_PER_NATURAL_LOG)));
+                __m128i rounded = _mm_cvtps_epi32(pitch);
+                __m128 deviation = _mm_mul_ps(_mm_sub_ps(pitch, _mm_cvtepi32_ps(rounded)), _mm_set1_ps(100.0f));
+                __m128i validBits = _mm_castps_si128(valid);
+                rounded = _mm_or_si128(_mm_and_si128(validBits, rounded), _mm_andnot_si128(validBits, _mm_set1_epi32(-1)));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(nearest + i), rounded);
+                _mm_storeu_ps(cents + i, _mm_and_ps(valid, deviation));
+            }
+            hzToMidiScalar(hz + i, nearest + i, cents + i, count - i, a4);
+        }
+
+        __attribute__((target("avx2")))
+        static __m256 exp2Avx2(__m256 x) {
+            __m256i whole = _mm256_cvtps_epi32(x);
+            __m256 f = _mm256_sub_ps(x, _mm256_cvtepi32_ps(whole));
+            __m256 p = _mm256_set1_ps(1.535336188319500e-4f);
+            p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(1.339887440266574e-3f));
+            p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(9.618437357674640e-3f));
+            p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(5.550332471162809e-2f));
+            p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(2.402264791363012e-1f));
+            p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(6.931472028550421e-1f));
+            p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(1.0f));
+            __m256i scale = _mm256_slli_epi32(_mm256_add_epi32(whole, _mm256_set1_epi32(127)), 23);
+            return _mm256_mul_ps(p, _mm256_castsi256_ps(scale));
+        }
+
+        __attribute__((target("avx2")))
+        static __m256 logAvx2(__m256 x) {
+            __m256i bits = _mm256_castps_si256(x);
+            __m256 exponent = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(126)));
+            __m256 m = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF)), _mm256_set1_epi32(0x3F000000)));
+
+            __m256 small = _mm256_cmp_ps(m, _mm256_set1_ps(0.707106781186547524f), _CMP_LT_OQ);
+            exponent = _mm256_sub_ps(exponent, _mm256_and_ps(small, _mm256_set1_ps(1.0f)));
+            m = _mm256_add_ps(_mm256_sub_ps(m, _mm256_set1_ps(1.0f)), _mm256_and_ps(small, m));
+
+            __m256 z = _mm256_mul_ps(m, m);
+            __m256 y = _mm256_set1_ps(7.0376836292e-2f);
+            y = _mm256_add_ps(_mm256_mul_ps(y, m), _mm256_set1_ps(-1.1514610310e-1f));
+            y = _mm256_add_ps(_mm256_mul_ps(y, m), _mm256_set1_ps(1.1676998740e-1f));
+            y = _mm256_add_ps(_mm256_mul_ps(y, m), _mm256_set1_ps(-1.2420140846e-1f));
+            y = _mm256_add_ps(_mm256_mul_ps(y, m), _mm256_set1_ps(1.4249322787e-1f));
+            y = _mm256_add_ps(_mm256_mul_ps(y, m), _mm256_set1_ps(-1.6668057665e-1f));
+            y = _mm256_add_ps(_mm256_mul_ps(y, m), _mm256_set1_ps(2.0000714765e-1f));
+            y = _mm256_add_ps(_mm256_mul_ps(y, m), _mm256_set1_ps(-2.4999993993e-1f));
+            y = _mm256_add_ps(_mm256_mul_ps(y, m), _mm256_set1_ps(3.3333331174e-1f));
+            y = _mm256_mul_ps(_mm256_mul_ps(y, m), z);
+            y = _mm256_add_ps(y, _mm256_mul_ps(exponent, _mm256_set1_ps(-2.12194440e-4f)));
+            y = _mm256_sub_ps(y, _mm256_mul_ps(z, _mm256_set1_ps(0.5f)));
+            return _mm256_add_ps(_mm256_add_ps(m, y), _mm256_mul_ps(exponent, _mm256_set1_ps(0.693359375f)));
+        }
+
+        __attribute__((target("avx2")))
+        static void midiToHzAvx2(const float* midi, const float* cents, float* hz, std::size_t count, float a4) {
+            const __m256 reference = _mm256_set1_ps(a4);
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                __m256 pitch = _mm256_loadu_ps(midi + i);
+                if (cents) pitch = _mm256_add_ps(pitch, _mm256_mul_ps(_mm256_loadu_ps(cents + i), _mm256_set1_ps(0.01f)));
+                __m256 octaves = _mm256_mul_ps(_mm256_sub_ps(pitch, _mm256_set1_ps(69.0f)), _mm256_set1_ps(1.0f / 12.0f));
+                _mm256_storeu_ps(hz + i, _mm256_mul_ps(reference, exp2Avx2(octaves)));
+            }
+            midiToHzSse(midi + i, cents ? cents + i : nullptr, hz + i, count - i, a4);
+        }
+
+        __attribute__((target("avx2")))
+        static void hzToMidiAvx2(const float* hz, std::int32_t* nearest, float* cents, std::size_t count, float a4) {
+            const __m256 inverseReference = _mm256_set1_ps(1.0f / a4);
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                __m256 input = _mm256_loadu_ps(hz + i);
+                __m256 ratio = _mm256_mul_ps(input, inverseReference);
+                __m256 valid = _mm256_and_ps(
+                    _mm256_and_ps(_mm256_cmp_ps(input, _mm256_setzero_ps(), _CMP_GT_OQ), _mm256_cmp_ps(input, _mm256_set1_ps(FLT_MAX), _CMP_LE_OQ)),
+                    _mm256_and_ps(_mm256_cmp_ps(ratio, _mm256_set1_ps(FLT_MIN), _CMP_GE_OQ), _mm256_cmp_ps(ratio, _mm256_set1_ps(FLT_MAX), _CMP_LE_OQ)));
+                ratio = _mm256_blendv_ps(_mm256_set1_ps(1.0f), ratio, valid);
+                __m256 pitch = _mm256_add_ps(_mm256_set1_ps(69.0f), _mm256_mul_ps(logAvx2(ratio), _mm256_set1_ps(SEMITONES_PER_NATURAL_LOG)));
+                __m256i rounded = _mm256_cvtps_epi32(pitch);
+                __m256 deviation = _mm256_mul_ps(_mm256_sub_ps(pitch, _mm256_cvtepi32_ps(rounded)), _mm256_set1_ps(100.0f));
+                rounded = _mm256_blendv_epi8(_mm256_set1_epi32(-1), rounded, _mm256_castps_si256(valid));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(nearest + i), rounded);
+                _mm256_storeu_ps(cents + i, _mm256_and_ps(valid, deviation));
+            }
+            hzToMidiSse(hz + i, nearest + i, cents + i, count - i, a4);
+        }
+#endif
+
+        void dispatchMidiToHz(const float* midi, const float* cents, float* hz, std::size_t count) const {
+#ifdef MUSIC_THEORY_X86
+            if (level == SimdLevel::AVX2) return midiToHzAvx2(midi, cents, hz, count, referenceA4);
+            if (level == SimdLevel::SSE2) return midiToHzSse(midi, cents, hz, count, referenceA4);
+#endif
+            midiToHzScalar(midi, cents, hz, count, referenceA4);
+        }
+
+    public:
+        static constexpr float CONCERT_A4 = 440.0f;
+        static constexpr float ORCHESTRAL_A4 = 442.0f;
+        static constexpr float VERDI_A4 = 432.0f;
+
+        // Best instruction set this CPU supports, detected once
+        static SimdLevel detectSimdLevel() {
+#ifdef MUSIC_THEORY_X86
+            static const SimdLevel detected = __builtin_cpu_supports("avx2") ? SimdLevel::AVX2 : SimdLevel::SSE2;
+            return detected;
+#else
+            return SimdLevel::Scalar;
+#endif
+        }
+
+        // Requests above what the CPU supports are lowered to the detected level
+        explicit FrequencyConverter(float a4 = CONCERT_A4, SimdLevel simdLevel = detectSimdLevel())
+            : referenceA4(a4), level(std::min(simdLevel, detectSimdLevel())) {}
+
+        float getReference() const { return referenceA4; }
+        SimdLevel getSimdLevel() const { return level; }
+
+        float midiToHz(float midi) const { return referenceA4 * std::exp2((midi - 69.0f) / 12.0f); }
+        float frequencyOf(const Note& note) const { return midiToHz(static_cast<float>(note.getMidiValue())); }
+
+        // Each batch call converts min(input size, output size) elements
+        void midiToHz(std::span<const float> midi, std::span<float> hz) const {
+            dispatchMidiToHz(midi.data(), nullptr, hz.data(), std::min(midi.size(), hz.size()));
+        }
+
+        // Pitch is midi[i] + cents[i] / 100
+        void midiToHz(std::span<const float> midi, std::span<const float> cents, std::span<float> hz) const {
+            std::size_t count = std::min({midi.size(), cents.size(), hz.size()});
+            dispatchMidiToHz(midi.data(), cents.data(), hz.data(), count);
+        }
+
+        // Nearest MIDI note and deviation from it in cents (-50..50). Non-positive
+        // frequencies, e.g. silence from a pitch tracker, map to -1 and 0 cents,
+        // as do NaN, infinities and frequencies too far from A4 to represent.
+        void hzToMidi(std::span<const float> hz, std::span<std::int32_t> nearestMidi, std::span<float> cents) const {
+            std::size_t count = std::min({hz.size(), nearestMidi.size(), cents.size()});
+#ifdef MUSIC_THEORY_X86
+            if (level == SimdLevel::AVX2) return hzToMidiAvx2(hz.data(), nearestMidi.data(), cents.data(), count, referenceA4);
+            if (level == SimdLevel::SSE2) return hzToMidiSse(hz.data(), nearestMidi.data(), cents.data(), count, referenceA4);
+#endif
+            hzToMidiScalar(hz.data(), nearestMidi.data(), cents.data(), count, referenceA4);
+        }
+};
@@ -0,0 +1,316 @@
+#pragma once
+
+#include "common.hpp"
+#include "catalog.hpp"
+#include "pitch_class_set.hpp"
+#include "spelling.hpp"
+#include "chord.hpp"
+#include "diatonic.hpp"
+#include "roman_numeral.hpp"
+
+// What a chord is doing in a key, roughly from most to least expected
+enum class HarmonicRole : std::uint8_t {
+    Tonic,     // Built on the tonic from the key's own notes
+    Diatonic,  // All of its notes are in the key (in minor, harmonic minor counts too)
+    Secondary, // Dominant or leading-tone chord of another diatonic chord, such as V7/ii
+    Borrowed,  // All of its notes are in the parallel key, such as bVI in major
+    Chromatic  // Nothing above
+};
+
+// One chord quality on one root read as a Roman numeral in a key
+struct ChordReading {
+    RomanNumeral numeral;
+    ChordType type = ChordType::Major;
+    HarmonicRole role = HarmonicRole::Chromatic;
+    std::uint8_t cost = 0; // How unlikely the reading is, for the analyzer to minimise
+    bool exact = false;    // Whether the numeral alone names the chord's quality
+
+    // e.g. "ii7", "V7/V" or, where the numeral can't carry the quality, "V(9)"
+    std::string getName() const {
+        if (exact) return numeral.getName();
+        RomanNumeral base = numeral;
+        base.extension = NumeralExtension::None;
+        if (base.marker == NumeralMarker::HalfDiminished) base.marker = NumeralMarker::Diminished;
+        std::string_view symbol = FormulaCatalog::get(type).symbol;
+        if (!base.root.upper && symbol.starts_with("m") && !symbol.starts_with("maj")) symbol.remove_prefix(1);
+        return base.getName() + "(" + std::string(symbol) + ")";
+    }
+};
+
+// The reading of every chord quality on every root relative to the tonic,
+// in major and in minor, worked out during constant evaluation so the
+// analyzer only ever looks readings up
+struct HarmonicReadingTable {
+    static constexpr std::size_t TYPE_COUNT = FormulaCatalog::CHORDS.size();
+
+    std::array<std::array<std::array<ChordReading, 12>, TYPE_COUNT>, 2> readings{}; // [minor][type][root - tonic]
+
+    static constexpr int position(ScaleType scale, int degree) {
+        int semitones = 0;
+        for (int i = 0; i < degree; ++i) semitones += FormulaCatalog::get(scale).steps[i];
+        return semitones;
+    }
+
+    static constexpr std::optional<int> degreeAt(ScaleType scale, int pitchClass) {
+        for (int degree = 0; degree < 7; ++degree) {
+            if (position(scale, degree) == pitchClass) return degree;
+        }
+        return std::nullopt;
+    }
+
+    // The numeral for a chord quality with the given root: case from its
+    // third, a marker for diminished and augmented fifths, 7 or maj7 from its seventh
+    static constexpr RomanNumeral numeralFor(ChordType type, RomanDegree root) {
+        PitchClassSet tones(FormulaCatalog::get(type).mask);
+        RomanNumeral numeral;
+        numeral.root = root;
+        numeral.root.upper = tones.contains(4) || !tones.contains(3);
+        bool diminished = tones.contains(3) && tones.contains(6) && !tones.contains(4) && !tones.contains(7);
+        if (type == ChordType::HalfDiminished7) {
+            numeral.marker = NumeralMarker::HalfDiminished;
+        } else if (diminished) {
+            numeral.marker = NumeralMarker::Diminished;
+        } else if (tones.contains(4) && tones.contains(8) && !tones.contains(7)) {
+            numeral.marker = NumeralMarker::Augmented;
+        }
+        if (tones.contains(10) || (diminished && tones.contains(9))) {
+            numeral.extension = NumeralExtension::Seventh;
+        } else if (tones.contains(11)) {
+            numeral.extension = NumeralExtension::MajorSeventh;
+        }
+        return numeral;
+    }
+
+    // A reading of a chord that lies in source, with its degree written
+    // relative to the key's own scale (so harmonic minor's leading tone is #vii)
+    static constexpr ChordReading inScale(ChordType type, ScaleType key, ScaleType source, int degree, HarmonicRole role, int cost) {
+        auto alteration = static_cast<std::int8_t>(position(source, degree) - position(key, degree));
+        ChordReading reading{numeralFor(type, RomanDegree{static_cast<std::int8_t>(degree), alteration, true}), type, role,
+                             static_cast<std::uint8_t>(cost), false};
+        reading.exact = reading.numeral.chordType(key) == type;
+        return reading;
+    }
+
+    static constexpr ChordReading classify(ChordType type, int root, ScaleType key, ScaleType parallel) {
+        PitchClassSet chord = PitchClassSet(FormulaCatalog::get(type).mask).transpose(root);
+        auto inside = [&](ScaleType scale) { return chord.isSubsetOf(PitchClassSet(FormulaCatalog::get(scale).mask)); };
+
+        // The tonic is free and the dominant nearly so, which is what tells a
+        // key from its relative: C-Am-G7-C costs less in C than in A minor
+        auto diatonic = [&](ScaleType source) {
+            int degree = *degreeAt(source, root);
+            if (degree == 0) return inScale(type, key, source, degree, HarmonicRole::Tonic, 0);
+            bool dominant = degree == 4 && PitchClassSet(FormulaCatalog::get(type).mask).contains(4);
+            return inScale(type, key, source, degree, HarmonicRole::Diatonic, dominant ? 1 : 2);
+        };
+        if (inside(key)) return diatonic(key);
+        if (key == ScaleType::Minor && inside(ScaleType::HarmonicMinor)) return diatonic(ScaleType::HarmonicMinor);
+
+        // Secondary dominants resolve down a fifth, leading-tone chords up a semitone,
+        // onto a major or minor diatonic chord other than the tonic
+        PitchClassSet tones(FormulaCatalog::get(type).mask);
+        bool dominant = tones.contains(4) && !tones.contains(11) && (tones.contains(10) || type == ChordType::Major);
+        bool leadingTone = type == ChordType::Diminished || type == ChordType::Diminished7 || type == ChordType::HalfDiminished7;
+        if (dominant || leadingTone) {
+            auto target = degreeAt(key, (root + (dominant ? 5 : 1)) % 12);
+            auto targetTriad = target ? DiatonicHarmony::get(key, *target).triad : std::nullopt;
+            if (target && *target != 0 && (targetTriad == ChordType::Major || targetTriad == ChordType::Minor)) {
+                bool upper = targetTriad == ChordType::Major;
+                ChordReading reading{numeralFor(type, RomanDegree{static_cast<std::int8_t>(dominant ? 4 : 6), 0, true}), type,
+                                     HarmonicRole::Secondary, 4, false};
+                reading.numeral.targets.push_back(RomanDegree{static_cast<std::int8_t>(*target), 0, upper});
+                reading.exact = reading.numeral.chordType(upper ? ScaleType::Major : ScaleType::Minor) == type;
+                return reading;
+            }
+        }
+
+        if (inside(parallel)) {
+            return inScale(type, key, parallel, *degreeAt(parallel, root), HarmonicRole::Borrowed, 5);
+        }
+
+        // Anything else is named from the nearest degree, flat before sharp: bII, bV, #iv
+        for (int alteration : {0, -1, 1}) {
+            if (auto degree = degreeAt(key, (root - alteration + 12) % 12)) {
+                ChordReading reading{numeralFor(type, RomanDegree{static_cast<std::int8_t>(*degree), static_cast<std::int8_t>(alteration), true}),
+                                     type, HarmonicRole::Chromatic, 8, false};
+                reading.exact = reading.numeral.chordType(key) == type;
+                return reading;
+            }
+        }
+        return ChordReading{};
+    }
+
+    constexpr HarmonicReadingTable() {
+        for (std::size_t type = 0; type < TYPE_COUNT; ++type) {
+            for (int root = 0; root < 12; ++root) {
+                readings[0][type][root] = classify(static_cast<ChordType>(type), root, ScaleType::Major, ScaleType::Minor);
+                readings[1][type][root] = classify(static_cast<ChordType>(type), root, ScaleType::Minor, ScaleType::Major);
+            }
+        }
+    }
+};
+
+struct AnalyzedChord {
+    Chord chord;
+    Key key;
+    ChordReading reading;
+};
+
+struct KeyRegion {
+    Key key;
+    std::size_t begin = 0; // First chord in the key
+    std::size_t end = 0;   // One past the last
+};
+
+enum class ModulationKind : std::uint8_t {
+    Pivot,    // A chord diatonic in both keys joins them
+    Parallel, // Same tonic, the other mode
+    Direct    // No preparation
+};
+
+struct Modulation {
+    std::size_t index = 0; // First chord in the new key
+    Key from;
+    Key to;
+    ModulationKind kind = ModulationKind::Direct;
+    std::size_t pivot = 0;    // For a pivot modulation, the chord read in both keys
+    ChordReading pivotBefore; // Its reading in the old key
+    ChordReading pivotAfter;  // Its reading in the new key
+};
+
+struct HarmonicAnalysis {
+    std::vector<AnalyzedChord> chords;
+    std::vector<KeyRegion> regions;
+    std::vector<Modulation> modulations;
+    int cost = 0;
+};
+
+struct HarmonicAnalyzerOptions {
+    int modulationCost = 5; // Charged for every change of key
+    int fifthCost = 1;      // Added per step apart on the circle of fifths, so near keys are cheaper
+};
+
+// Reads a chord sequence as Roman numerals in a succession of keys. Every
+// chord has a reading in each of the 24 major and minor keys, each with a
+// cost from the reading table; a Viterbi pass picks the cheapest key for
+// every chord, charging for each modulation by how far apart the keys are.
+// The work is chords x 24 x 24, linear in the length of the song.
+class HarmonicAnalyzer {
+    private:
+        static constexpr HarmonicReadingTable TABLE{};
+        static constexpr std::size_t KEY_COUNT = 24;
+
+        static constexpr Key keyAt(std::size_t index) {
+            return Key{index < 12 ? ScaleType::Major : ScaleType::Minor, static_cast<std::uint8_t>(index % 12)};
+        }
+
+        // Position on the circle of fifths of the key signature, 0 .. 11
+        static constexpr int signature(std::size_t index) {
+            int relativeMajor = index < 12 ? static_cast<int>(index) : static_cast<int>(index % 12 + 3) % 12;
+            return relativeMajor * 7 % 12;
+        }
+
+        // Steps between key signatures, except that a parallel key counts as
+        // one step: C major to C minor is as ordinary a move as C to G
+        static constexpr int keysApart(std::size_t a, std::size_t b) {
+            if (a % 12 == b % 12 && a != b) return 1;
+            int distance = (signature(a) - signature(b) + 12) % 12;
+            return std::min(distance, 12 - distance);
+        }
+
+        static constexpr bool isDiatonic(const ChordReading& reading) {
+            return reading.role == HarmonicRole::Tonic || reading.role == HarmonicRole::Diatonic;
+        }
+
+    public:
+        static constexpr const ChordReading& read(const Chord& chord, const Key& key) {
+            int root = (chord.getRoot().getPitchClass() - key.tonic + 12) % 12;
+            return TABLE.readings[key.isMinor() ? 1 : 0][static_cast<std::size_t>(chord.getType())][root];
+        }
+
+        static HarmonicAnalysis analyze(std::span<const Chord> chords, const HarmonicAnalyzerOptions& options = {}) {
+            HarmonicAnalysis analysis;
+            if (chords.empty()) return analysis;
+
+            std::array<std::array<int, KEY_COUNT>, KEY_COUNT> transition{};
+            for (std::size_t a = 0; a < KEY_COUNT; ++a) {
+                for (std::size_t b = 0; b < KEY_COUNT; ++b) {
+                    transition[a][b] = a == b ? 0 : options.modulationCost + options.fifthCost * keysApart(a, b);
+                }
+            }
+
+            std::array<int, KEY_COUNT> cost{};
+            std::vector<std::array<std::uint8_t, KEY_COUNT>> previous(chords.size());
+            for (std::size_t step = 0; step < chords.size(); ++step) {
+                std::array<int, KEY_COUNT> next{};
+                for (std::size_t key = 0; key < KEY_COUNT; ++key) {
+                    // Staying put wins ties, so keys only change when it pays
+                    std::size_t from = key;
+                    int best = cost[key];
+                    if (step > 0) {
+                        for (std::size_t other = 0; other < KEY_COUNT; ++other) {
+                            int candidate = cost[other] + transition[other][key];
+                            if (candidate < best) {
+                                best = candidate;
+                                from = other;
+                            }
+                        }
+                    }
+                    next[key] = best + read(chords[step], keyAt(key)).cost;
+                    previous[step][key] = static_cast<std::uint8_t>(from);
+                }
+                cost = next;
+            }
+
+            std::size_t key = static_cast<std::size_t>(std::min_element(cost.begin(), cost.end()) - cost.begin());
+            analysis.cost = cost[key];
+            analysis.chords.resize(chords.size(), AnalyzedChord{chords[0], Key{}, ChordReading{}});
+            for (std::size_t step = chords.size(); step-- > 0;) {
+                analysis.chords[step] = AnalyzedChord{chords[step], keyAt(key), read(chords[step], keyAt(key))};
+                key = previous[step][key];
+            }
+
+            for (std::size_t i = 0; i < chords.size(); ++i) {
+                if (i > 0 && analysis.chords[i].key == analysis.regions.back().key) {
+                    analysis.regions.back().end = i + 1;
+                    continue;
+                }
+                analysis.regions.push_back(KeyRegion{analysis.chords[i].key, i, i + 1});
+                if (i == 0) continue;
+
+                Modulation modulation;
+                modulation.index = i;
+                modulation.from = analysis.chords[i - 1].key;
+                modulation.to = analysis.chords[i].key;
+                // The pivot is the last chord heard in both keys before one that belongs
+                // only to the new key; failing that, the last chord of the old key
+                auto common = [&](std::size_t index) {
+                    return isDiatonic(read(chords[index], modulation.from)) && isDiatonic(read(chords[index], modulation.to));
+                };
+                std::optional<std::size_t> pivot;
+                if (common(i)) {
+                    pivot = i;
+                    while (*pivot + 1 < chords.size() && analysis.chords[*pivot + 1].key == modulation.to && common(*pivot + 1)) ++*pivot;
+                } else if (common(i - 1)) {
+                    pivot = i - 1;
+                }
+                if (pivot) {
+                    modulation.kind = ModulationKind::Pivot;
+                    modulation.pivot = *pivot;
+                    modulation.pivotBefore = read(chords[*pivot], modulation.from);
+                    modulation.pivotAfter = read(chords[*pivot], modulation.to);
+                }
+                if (modulation.kind != ModulationKind::Pivot && modulation.from.tonic == modulation.to.tonic) {
+                    modulation.kind = ModulationKind::Parallel;
+                }
+                analysis.modulations.push_back(modulation);
+            }
+            return analysis;
+        }
+};
+
+static_assert(HarmonicAnalyzer::read(Chord(ChordType::Minor7, Note(62)), Key{ScaleType::Major, 0}).role == HarmonicRole::Diatonic);
+static_assert(HarmonicAnalyzer::read(Chord(ChordType::Dominant7, Note(62)), Key{ScaleType::Major, 0}).role == HarmonicRole::Secondary);
+static_assert(HarmonicAnalyzer::read(Chord(ChordType::Major, Note(68)), Key{ScaleType::Major, 0}).role == HarmonicRole::Borrowed);
+static_assert(HarmonicAnalyzer::read(Chord(ChordType::Dominant7, Note(67)), Key{ScaleType::Minor, 0}).role == HarmonicRole::Diatonic);
+static_assert(HarmonicAnalyzer::read(Chord(ChordType::Diminished7, Note(71)), Key{ScaleType::Minor, 0}).numeral.root.alteration == 1);
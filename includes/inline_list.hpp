@@ -0,0 +1,72 @@
+#pragma once
+
+#include "common.hpp"
+#include <exception>
+
+// A fixed-capacity list stored inline: no heap, trivially copyable whenever
+// T is, and usable in constant expressions. Used wherever a musical object
+// holds a handful of values (intervals, chord tones, voicing notes) and a
+// std::vector would cost an allocation per object.
+template <typename T, std::size_t Capacity>
+class InlineList {
+    static_assert(Capacity <= 255, "InlineList keeps its size in one byte");
+
+    private:
+        std::array<T, Capacity> items{};
+        std::uint8_t count = 0;
+
+    public:
+        constexpr InlineList() = default;
+        constexpr InlineList(std::initializer_list<T> values) {
+            for (const T& value : values) push_back(value);
+        }
+
+        // Pushing onto a full list is a logic error in the caller: it
+        // terminates at run time, release builds included, and is not a
+        // constant expression
+        constexpr void push_back(const T& value) {
+            if (count == Capacity) std::terminate();
+            items[count++] = value;
+        }
+
+        constexpr void clear() { count = 0; }
+
+        constexpr std::size_t size() const { return count; }
+        static constexpr std::size_t capacity() { return Capacity; }
+        constexpr bool empty() const { return count == 0; }
+        constexpr bool full() const { return count == Capacity; }
+
+        constexpr T& operator[](std::size_t i) { return items[i]; }
+        constexpr const T& operator[](std::size_t i) const { return items[i]; }
+        constexpr const T& front() const { return items[0]; }
+        constexpr const T& back() const { return items[count - 1]; }
+
+        constexpr T* begin() { return items.data(); }
+        constexpr T* end() { return items.data() + count; }
+        constexpr const T* begin() const { return items.data(); }
+        constexpr const T* end() const { return items.data() + count; }
+        constexpr const T* data() const { return items.data(); }
+
+        constexpr operator std::span<const T>() const { return {items.data(), count}; }
+
+        constexpr bool contains(const T& value) const {
+            for (std::size_t i = 0; i < count; ++i) {
+                if (items[i] == value) return true;
+            }
+            return false;
+        }
+
+        constexpr bool operator==(const InlineList& other) const {
+            if (count != other.count) return false;
+            for (std::size_t i = 0; i < count; ++i) {
+                if (!(items[i] == other.items[i])) return false;
+            }
+            return true;
+        }
+};
+
+// Semitone steps or offsets of a scale or chord: at most one per pitch class
+using IntervalList = InlineList<std::uint8_t, 12>;
+
+static_assert(sizeof(IntervalList) == 13);
+static_assert(std::is_trivially_copyable_v<IntervalList>);
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "common.hpp"
+#include "note.hpp"
+#include "pitch_class_set.hpp"
+#include "catalog.hpp"
+#include "spelling.hpp"
+#include "chord.hpp"
+#include <cmath>
+
+// Key profiles: how strongly each scale degree suggests a key, major and
+// minor, indexed by semitones above the tonic
+enum class KeyProfile : std::uint8_t {
+    KrumhanslKessler, // Probe-tone ratings from listening experiments
+    Temperley,        // Degree frequencies counted in the Kostka-Payne corpus
+    Count
+};
+
+constexpr std::string_view keyProfileName(KeyProfile profile) {
+    constexpr std::array<std::string_view, static_cast<std::size_t>(KeyProfile::Count)> NAMES = {
+        "Krumhansl-Kessler", "Temperley"
+    };
+    return NAMES[static_cast<std::size_t>(profile)];
+}
+
+struct KeyEstimate {
+    Key key;
+    double correlation = 0; // Pearson correlation of the histogram with the key's profile, -1 .. 1
+    double confidence = 0;  // Lead over the runner-up's correlation
+
+    std::string getName() const {
+        return std::string(Speller::tonic(key).getName()) + " " + std::string(FormulaCatalog::get(key.type).name);
+    }
+};
+
+// Every profile rotated onto every key, centred on its own mean. Keys
+// 0 .. 11 are major on each tonic, 12 .. 23 minor. Subtracting the mean up
+// front turns the correlation's covariance term into a plain dot product.
+struct KeyProfileTable {
+    static constexpr std::size_t PROFILE_COUNT = static_cast<std::size_t>(KeyProfile::Count);
+    static constexpr std::size_t KEY_COUNT = 24;
+
+    // weights[profile][pc][key]: what one occurrence of pc adds to key's dot product
+    std::array<std::array<std::array<double, KEY_COUNT>, 12>, PROFILE_COUNT> weights{};
+    std::array<std::array<double, 2>, PROFILE_COUNT> squaredNorms{}; // Per profile, major then minor
+
+    constexpr KeyProfileTable() {
+        constexpr std::array<std::array<std::array<double, 12>, 2>, PROFILE_COUNT> PROFILES = {{
+            {{{6.35, 2.23, 3.48, 2.33, 4.38, 4.09, 2.52, 5.19, 2.39, 3.66, 2.29, 2.88},
+              {6.33, 2.68, 3.52, 5.38, 2.60, 3.53, 2.54, 4.75, 3.98, 2.69, 3.34, 3.17}}},
+            {{{0.748, 0.060, 0.488, 0.082, 0.670, 0.460, 0.096, 0.715, 0.104, 0.366, 0.057, 0.400},
+              {0.712, 0.084, 0.474, 0.618, 0.049, 0.460, 0.105, 0.747, 0.404, 0.067, 0.133, 0.330}}},
+        }};
+
+        for (std::size_t profile = 0; profile < PROFILE_COUNT; ++profile) {
+            for (std::size_t minor = 0; minor < 2; ++minor) {
+                const auto& values = PROFILES[profile][minor];
+                double mean = 0;
+                for (double value : values) mean += value / 12;
+                for (double value : values) squaredNorms[profile][minor] += (value - mean) * (value - mean);
+
+                for (int tonic = 0; tonic < 12; ++tonic) {
+                    for (int pc = 0; pc < 12; ++pc) {
+                        weights[profile][pc][minor * 12 + tonic] = values[(pc - tonic + 12) % 12] - mean;
+                    }
+                }
+            }
+        }
+    }
+};
+
+// Guesses the key of a stream of notes or chords as it arrives. The
+// pitch-class histogram decays geometrically, so recent events count most,
+// and the dot product of the histogram with every key's profile is kept
+// current: an event costs 24 multiply-adds per pitch class it sounds, and
+// asking for the best key is one pass over the 24 running totals.
+class KeyFinder {
+    private:
+        static constexpr KeyProfileTable TABLE{};
+
+        KeyProfile profile;
+        double decay; // Multiplier applied to everything already heard, per event
+        std::array<double, 12> histogram{};
+        std::array<double, KeyProfileTable::KEY_COUNT> dots{};
+        std::array<double, 2> profileNorms{};
+        std::size_t events = 0;
+
+        void fade() {
+            if (decay == 1.0) return;
+            for (double& count : histogram) count *= decay;
+            for (double& dot : dots) dot *= decay;
+        }
+
+        void add(int pc, double weight) {
+            histogram[pc] += weight;
+            const auto& row = TABLE.weights[static_cast<std::size_t>(profile)][pc];
+            for (std::size_t key = 0; key < dots.size(); ++key) dots[key] += weight * row[key];
+        }
+
+        static constexpr Key keyAt(std::size_t index) {
+            return Key{index < 12 ? ScaleType::Major : ScaleType::Minor, static_cast<std::uint8_t>(index % 12)};
+        }
+
+    public:
+        // halfLife is the number of events after which an event counts half
+        // as much as a new one; zero or less never forgets
+        explicit KeyFinder(KeyProfile keyProfile = KeyProfile::Temperley, double halfLife = 32)
+            : profile(keyProfile), decay(halfLife > 0 ? std::pow(0.5, 1.0 / halfLife) : 1.0) {
+            for (std::size_t minor = 0; minor < 2; ++minor) {
+                profileNorms[minor] = std::sqrt(TABLE.squaredNorms[static_cast<std::size_t>(profile)][minor]);
+            }
+        }
+
+        // One note, weighted by e.g. its duration in beats
+        void push(int pitchClass, double weight = 1.0) {
+            fade();
+            add(((pitchClass % 12) + 12) % 12, weight);
+            ++events;
+        }
+
+        void push(const Note& note, double weight = 1.0) { push(note.getPitchClass(), weight); }
+
+        // Everything sounding at once, such as a chord from a chart, as one event
+        void push(PitchClassSet notes, double weight = 1.0) {
+            fade();
+            notes.forEach([&](int pc) { add(pc, weight); });
+            ++events;
+        }
+
+        void push(const Chord& chord, double weight = 1.0) { push(chord.getPitchClassSet(), weight); }
+
+        void reset() {
+            histogram.fill(0);
+            dots.fill(0);
+            events = 0;
+        }
+
+        std::size_t size() const { return events; }
+        KeyProfile getProfile() const { return profile; }
+        const std::array<double, 12>& getHistogram() const { return histogram; }
+
+        // Correlation of the current histogram with every key, in key order
+        // (major on C .. B, then minor); all zero while the histogram is flat
+        std::array<double, KeyProfileTable::KEY_COUNT> correlations() const {
+            std::array<double, KeyProfileTable::KEY_COUNT> result{};
+            double sum = 0, sumOfSquares = 0;
+            for (double count : histogram) {
+                sum += count;
+                sumOfSquares += count * count;
+            }
+            double variance = sumOfSquares - sum * sum / 12;
+            if (variance <= 1e-12 * sumOfSquares) return result;
+
+            double spread = std::sqrt(variance);
+            for (std::size_t key = 0; key < result.size(); ++key) {
+                result[key] = dots[key] / (spread * profileNorms[key / 12]);
+            }
+            return result;
+        }
+
+        // The count most likely keys, best first; each one's confidence is its
+        // lead over the next. Empty until the histogram favours some pitch class.
+        std::vector<KeyEstimate> ranked(std::size_t count) const {
+            auto scores = correlations();
+            if (std::all_of(scores.begin(), scores.end(), [](double score) { return score == 0; })) return {};
+            std::array<std::uint8_t, KeyProfileTable::KEY_COUNT> order{};
+            for (std::size_t i = 0; i < order.size(); ++i) order[i] = static_cast<std::uint8_t>(i);
+
+            count = std::min(count, order.size());
+            // One more than asked for, so the last one shown still has a runner-up
+            std::size_t sorted = std::min(count + 1, order.size());
+            std::partial_sort(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(sorted), order.end(),
+                              [&](std::uint8_t a, std::uint8_t b) { return scores[a] != scores[b] ? scores[a] > scores[b] : a < b; });
+
+            std::vector<KeyEstimate> estimates;
+            estimates.reserve(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                double next = i + 1 < order.size() ? scores[order[i + 1]] : scores[order[i]];
+                estimates.push_back({keyAt(order[i]), scores[order[i]], scores[order[i]] - next});
+            }
+            return estimates;
+        }
+
+        // The most likely key in a single pass, or nullopt before any pitch class stands out
+        std::optional<KeyEstimate> best() const {
+            auto scores = correlations();
+            std::size_t first = 0, second = 1;
+            if (scores[second] > scores[first]) std::swap(first, second);
+            for (std::size_t key = 2; key < scores.size(); ++key) {
+                if (scores[key] > scores[first]) {
+                    second = first;
+                    first = key;
+                } else if (scores[key] > scores[second]) {
+                    second = key;
+                }
+            }
+            if (scores[first] == 0 && scores[second] == 0) return std::nullopt;
+            return KeyEstimate{keyAt(first), scores[first], scores[first] - scores[second]};
+        }
+};
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "common.hpp"
+#include "note.hpp"
+#include "pitch_class_set.hpp"
+#include "scale_catalog.hpp"
+#include "scale_view.hpp"
+#include <iterator>
+#include <ranges>
+
+// One rotation of a scale: the parent's shape re-rooted on one of its
+// degrees. Only the rotated 12-bit shape and the root are stored; step
+// sizes are read from the catalog entry on demand rather than copied.
+class Mode {
+    private:
+        PitchClassSet shape; // Pitch classes relative to this mode's root
+        Note root;
+        std::uint8_t degree = 0; // 0-based degree of the parent scale this mode starts on
+
+    public:
+        constexpr Mode() = default;
+        constexpr Mode(PitchClassSet modeShape, const Note& modeRoot, int parentDegree)
+            : shape(modeShape), root(modeRoot), degree(static_cast<std::uint8_t>(parentDegree)) {}
+
+        constexpr int getDegree() const { return degree; }
+        constexpr Note getRoot() const { return root; }
+        constexpr PitchClassSet getShape() const { return shape; }
+        constexpr PitchClassSet getPitchClassSet() const { return shape.transpose(root.getPitchClass()); }
+        constexpr int size() const { return shape.size(); }
+
+        // Semitones from degree i to degree i + 1 of this mode
+        constexpr int getStep(int i) const { return ScaleCatalog::get(shape).getStep(i); }
+
+        // Catalog name, or "" if this rotation has none
+        constexpr std::string_view getName() const { return ScaleCatalog::nameOf(shape); }
+
+        constexpr ScaleView view(int lowMidi, int highMidi, Direction direction = Direction::Ascending) const {
+            return ScaleView(getPitchClassSet(), lowMidi, highMidi, direction);
+        }
+};
+
+// Every rotation of a scale in a single pass: each step re-roots the running
+// shape with one 12-bit rotation, so enumerating modes never copies intervals.
+class ModeRange : public std::ranges::view_interface<ModeRange> {
+    private:
+        PitchClassSet shape;
+        Note root;
+
+    public:
+        class Iterator {
+            private:
+                Mode current;
+
+            public:
+                using value_type = Mode;
+                using difference_type = std::ptrdiff_t;
+                using iterator_concept = std::forward_iterator_tag;
+
+                constexpr Iterator() = default;
+                constexpr explicit Iterator(Mode start) : current(start) {}
+
+                constexpr Mode operator*() const { return current; }
+
+                constexpr Iterator& operator++() {
+                    int step = current.getStep(0);
+                    current = Mode(current.getShape().transpose(-step), current.getRoot().transpose(step), current.getDegree() + 1);
+                    return *this;
+                }
+
+                constexpr Iterator operator++(int) {
+                    Iterator previous = *this;
+                    ++*this;
+                    return previous;
+                }
+
+                constexpr bool operator==(const Iterator& other) const { return current.getDegree() == other.current.getDegree(); }
+                constexpr bool operator==(std::default_sentinel_t) const { return current.getDegree() >= current.size(); }
+        };
+
+        constexpr ModeRange() = default;
+
+        // shape must contain pitch class 0, the parent scale's root
+        constexpr ModeRange(PitchClassSet parentShape, const Note& parentRoot) : shape(parentShape), root(parentRoot) {}
+
+        constexpr Iterator begin() const { return Iterator(Mode(shape, root, 0)); }
+        constexpr std::default_sentinel_t end() const { return std::default_sentinel; }
+        constexpr std::size_t size() const { return static_cast<std::size_t>(shape.size()); }
+};
+
+static_assert(std::ranges::forward_range<ModeRange>);
+static_assert(std::ranges::view<ModeRange>);
+static_assert((*std::next(ModeRange(*ScaleCatalog::find("Major"), Note(60)).begin(), 4)).getName() == "Mixolydian");
+static_assert((*std::next(ModeRange(*ScaleCatalog::find("Major"), Note(60)).begin(), 4)).getRoot() == Note(67));
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "common.hpp"
+
+// A pitch stored as a bare MIDI number. Names are resolved on demand from a
+// static table, so a Note is a 2-byte trivially-copyable value.
+class Note {
+    private:
+        std::int16_t midiValue = 0; // MIDI value for the note (C4 = 60)
+
+    public:
+        static constexpr std::array<std::string_view, 12> ALL_NOTES = {
+            "C", "C#/Db", "D", "D#/Eb", "E", "F", "F#/Gb", "G", "G#/Ab", "A", "A#/Bb", "B"
+        };
+
+        constexpr Note() = default;
+        constexpr explicit Note(int value) : midiValue(static_cast<std::int16_t>(value)) {}
+
+        constexpr int getMidiValue() const { return midiValue; }
+
+        // Position within the octave, 0 (C) to 11 (B); also valid below MIDI 0
+        constexpr int getPitchClass() const { return ((midiValue % 12) + 12) % 12; }
+
+        constexpr std::string_view getName() const { return ALL_NOTES[getPitchClass()]; }
+
+        // Returns a note that is a specified number of semitones above this note
+        constexpr Note transpose(int semitones) const { return Note(midiValue + semitones); }
+
+        constexpr bool operator==(const Note&) const = default;
+};
+
+static_assert(sizeof(Note) <= 2, "Note must stay a 2-byte value");
+static_assert(std::is_trivially_copyable_v<Note>, "Note must be trivially copyable");
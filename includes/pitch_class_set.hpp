@@ -0,0 +1,115 @@
+#pragma once
+
+#include "common.hpp"
+#include "note.hpp"
+
+// A set of pitch classes packed into the low 12 bits of a uint16_t, bit 0 = C.
+// Membership, union and intersection are single bitwise operations, and
+// transposition is a 12-bit rotation.
+class PitchClassSet {
+    private:
+        std::uint16_t mask = 0;
+
+        static constexpr std::uint16_t FULL_MASK = 0x0FFF;
+
+        static constexpr int wrap(int pitchClass) { return ((pitchClass % 12) + 12) % 12; }
+
+    public:
+        constexpr PitchClassSet() = default;
+        constexpr explicit PitchClassSet(std::uint16_t bits) : mask(bits & FULL_MASK) {}
+
+        static constexpr PitchClassSet fromPitchClasses(std::initializer_list<int> pitchClasses) {
+            PitchClassSet set;
+            for (int pc : pitchClasses) {
+                set = set.with(pc);
+            }
+            return set;
+        }
+
+        static constexpr PitchClassSet chromatic() { return PitchClassSet(FULL_MASK); }
+
+        constexpr std::uint16_t getMask() const { return mask; }
+        constexpr int size() const { return std::popcount(mask); }
+        constexpr bool empty() const { return mask == 0; }
+
+        constexpr bool contains(int pitchClass) const { return (mask >> wrap(pitchClass)) & 1; }
+        constexpr bool contains(const Note& note) const { return (mask >> note.getPitchClass()) & 1; }
+        constexpr bool isSubsetOf(PitchClassSet other) const { return (mask & ~other.mask) == 0; }
+
+        constexpr PitchClassSet with(int pitchClass) const {
+            return PitchClassSet(static_cast<std::uint16_t>(mask | (1u << wrap(pitchClass))));
+        }
+
+        constexpr PitchClassSet without(int pitchClass) const {
+            return PitchClassSet(static_cast<std::uint16_t>(mask & ~(1u << wrap(pitchClass))));
+        }
+
+        // T(n): rotates every member up by the given number of semitones
+        constexpr PitchClassSet transpose(int semitones) const {
+            int n = wrap(semitones);
+            return PitchClassSet(static_cast<std::uint16_t>((mask << n) | (mask >> (12 - n))));
+        }
+
+        // T(n)I: reflects every member pc to (axis - pc)
+        constexpr PitchClassSet invert(int axis = 0) const {
+            std::uint16_t reflected = 0;
+            for (int pc = 0; pc < 12; ++pc) {
+                if (contains(pc)) {
+                    reflected |= 1u << wrap(axis - pc);
+                }
+            }
+            return PitchClassSet(reflected);
+        }
+
+        constexpr PitchClassSet complement() const { return PitchClassSet(static_cast<std::uint16_t>(~mask)); }
+
+        // Lowest pitch class in the set, or -1 if empty
+        constexpr int lowest() const { return empty() ? -1 : std::countr_zero(mask); }
+
+        // Pitch class on which the normal order (Rahn) begins, or -1 if empty.
+        // For sets that contain 0, comparing two rotations as integers is the
+        // same as comparing their members from the top down, so the most
+        // compact rotation is simply the smallest mask.
+        constexpr int normalFormStart() const {
+            int best = -1;
+            std::uint16_t bestMask = FULL_MASK + 1;
+            for (int pc = 0; pc < 12; ++pc) {
+                if (!contains(pc)) continue;
+                std::uint16_t rotated = transpose(-pc).mask;
+                if (rotated < bestMask) {
+                    bestMask = rotated;
+                    best = pc;
+                }
+            }
+            return best;
+        }
+
+        // The normal order transposed so that it begins on 0
+        constexpr PitchClassSet normalForm() const {
+            return empty() ? *this : transpose(-normalFormStart());
+        }
+
+        // The more compact of the normal forms of this set and its inversion
+        constexpr PitchClassSet primeForm() const {
+            PitchClassSet original = normalForm();
+            PitchClassSet inverted = invert().normalForm();
+            return inverted.mask < original.mask ? inverted : original;
+        }
+
+        // Calls fn(pitchClass) for each member in ascending order
+        template <typename Fn>
+        constexpr void forEach(Fn&& fn) const {
+            for (std::uint16_t bits = mask; bits != 0; bits &= bits - 1) {
+                fn(std::countr_zero(bits));
+            }
+        }
+
+        constexpr PitchClassSet operator|(PitchClassSet other) const { return PitchClassSet(static_cast<std::uint16_t>(mask | other.mask)); }
+        constexpr PitchClassSet operator&(PitchClassSet other) const { return PitchClassSet(static_cast<std::uint16_t>(mask & other.mask)); }
+        constexpr PitchClassSet operator^(PitchClassSet other) const { return PitchClassSet(static_cast<std::uint16_t>(mask ^ other.mask)); }
+        constexpr bool operator==(const PitchClassSet&) const = default;
+};
+
+static_assert(PitchClassSet::fromPitchClasses({0, 4, 7}).transpose(5) == PitchClassSet::fromPitchClasses({5, 9, 0}));
+static_assert(PitchClassSet::fromPitchClasses({0, 4, 7}).primeForm() == PitchClassSet::fromPitchClasses({0, 3, 7}));
+static_assert(PitchClassSet::fromPitchClasses({11, 2, 7}).normalFormStart() == 7);
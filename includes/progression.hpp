@@ -0,0 +1,183 @@
+#pragma once
+
+#include "common.hpp"
+#include "note.hpp"
+#include "catalog.hpp"
+#include "spelling.hpp"
+#include "scale.hpp"
+#include "chord.hpp"
+#include "roman_numeral.hpp"
+#include "voice_leading.hpp"
+
+class ChordProgression {
+    private:
+        std::string name;
+        std::vector<Chord> chords;
+        std::vector<std::uint8_t> bassOffsets; // Semitones from each chord's root to its bass, 0 in root position
+
+    public:
+        ChordProgression(const std::string& progressionName, std::vector<Chord> progressionChords, std::vector<std::uint8_t> progressionBassOffsets = {})
+            : name(progressionName), chords(std::move(progressionChords)), bassOffsets(std::move(progressionBassOffsets)) {
+            bassOffsets.resize(chords.size(), 0);
+        }
+        
+        // Chord symbol with a slash bass for inversions, e.g. G7/B
+        std::string getChordName(size_t i) const {
+            std::string chordName = chords[i].getName();
+            if (bassOffsets[i] != 0) {
+                chordName += "/";
+                chordName += chords[i].spellTone(bassOffsets[i]).getName();
+            }
+            return chordName;
+        }
+        
+        void print() const {
+            std::cout << name << " Progression:" << std::endl;
+            for (size_t i = 0; i < chords.size(); ++i) {
+                std::cout << "  " << (i+1) << ". " << getChordName(i) << std::endl;
+            }
+        }
+        
+        const std::vector<Chord>& getChords() const { return chords; }
+        
+        // Prints one voicing per chord, chosen for the smoothest voice leading
+        void printVoiceLeading(const VoiceLeadingOptions& options = {}) const {
+            VoiceLeading leading = VoiceLeadingSolver::solve(chords, options);
+            if (leading.voicings.size() != chords.size()) {
+                std::cout << "Smooth voice leading: no voicing available for every chord in this register." << std::endl;
+                return;
+            }
+            std::cout << "Smooth voice leading (" << leading.totalMotion << " semitones of total motion):" << std::endl;
+            for (size_t i = 0; i < chords.size(); ++i) {
+                std::cout << "  " << std::left << std::setw(8) << getChordName(i) << std::right;
+                for (Note note : leading.voicings[i].getNotes()) {
+                    std::cout << " " << chords[i].spellPitchClass(note.getPitchClass()).getName() << (note.getMidiValue() / 12 - 1);
+                }
+                std::cout << std::endl;
+            }
+        }
+        
+        static ChordProgression createFromRomanNumerals(const Scale& scale, std::span<const RomanNumeral> numerals, const std::string& name) {
+            std::vector<Chord> progressionChords;
+            std::vector<std::uint8_t> bassOffsets;
+            progressionChords.reserve(numerals.size());
+            bassOffsets.reserve(numerals.size());
+            
+            for (const RomanNumeral& numeral : numerals) {
+                Chord chord = numeral.realize(scale);
+                progressionChords.push_back(chord);
+                bassOffsets.push_back(static_cast<std::uint8_t>(numeral.bassOffset(chord)));
+            }
+            
+            return ChordProgression(name, std::move(progressionChords), std::move(bassOffsets));
+        }
+        
+        // Numerals that fail to parse are skipped
+        static ChordProgression createFromRomanNumerals(const Scale& scale, const std::vector<std::string>& numerals, const std::string& name) {
+            std::vector<RomanNumeral> parsed;
+            for (const auto& numeral : numerals) {
+                if (auto roman = RomanNumeralParser::parse(numeral)) parsed.push_back(*roman);
+            }
+            return createFromRomanNumerals(scale, parsed, name);
+        }
+};
+
+// One chord of a key-independent progression: where its root sits above
+// the tonic, its quality, and enough spelling information to name it
+// correctly in any key. Four bytes, trivially copyable.
+struct DegreeChord {
+    std::uint8_t offset = 0;     // Semitones from the tonic to the chord root
+    ChordType type = ChordType::Major;
+    std::uint8_t letterStep = 0; // Letters from the tonic's letter to the root's, so bVII stays a 7th-degree letter
+    std::uint8_t bassOffset = 0; // Semitones from the chord root to the bass, 0 in root position
+
+    constexpr bool operator==(const DegreeChord&) const = default;
+};
+
+static_assert(sizeof(DegreeChord) == 4);
+static_assert(std::is_trivially_copyable_v<DegreeChord>);
+
+// Tonic spelling for every key in both modes, e.g. Eb rather than D# for major
+struct TonicTable {
+    std::array<std::array<SpelledPitch, 12>, 2> tonics{};
+
+    constexpr TonicTable() {
+        for (int pc = 0; pc < 12; ++pc) {
+            tonics[0][pc] = Speller::tonic(Key{ScaleType::Major, static_cast<std::uint8_t>(pc)});
+            tonics[1][pc] = Speller::tonic(Key{ScaleType::Minor, static_cast<std::uint8_t>(pc)});
+        }
+    }
+};
+
+// A progression stored as scale degrees and qualities rather than concrete
+// chords. Realizing it in a key is one addition per chord plus a letter
+// lookup for the spelling; no Scale is rebuilt and no numeral is re-parsed.
+class DegreeProgression {
+    private:
+        ScaleType mode = ScaleType::Major; // Decides key signatures when spelling the tonic
+        std::vector<DegreeChord> chords;
+
+        static constexpr TonicTable TONICS{};
+
+        constexpr bool isMinor() const { return Key{mode, 0}.isMinor(); }
+
+    public:
+        DegreeProgression() = default;
+        DegreeProgression(ScaleType progressionMode, std::vector<DegreeChord> progressionChords)
+            : mode(progressionMode), chords(std::move(progressionChords)) {}
+
+        // Realizes the numerals once against C and keeps only their offsets from the tonic
+        static DegreeProgression fromRomanNumerals(ScaleType mode, std::span<const RomanNumeral> numerals) {
+            Scale reference(mode, Note(60));
+            SpelledPitch tonic = reference.spell(0);
+            std::vector<DegreeChord> degreeChords;
+            degreeChords.reserve(numerals.size());
+            for (const RomanNumeral& numeral : numerals) {
+                Chord chord = numeral.realize(reference);
+                degreeChords.push_back({static_cast<std::uint8_t>(chord.getRoot().getPitchClass()), chord.getType(),
+                                        static_cast<std::uint8_t>((chord.getRootSpelling().letter - tonic.letter + 7) % 7),
+                                        static_cast<std::uint8_t>(numeral.bassOffset(chord))});
+            }
+            return DegreeProgression(mode, std::move(degreeChords));
+        }
+
+        ScaleType getMode() const { return mode; }
+        std::span<const DegreeChord> getChords() const { return chords; }
+        std::size_t size() const { return chords.size(); }
+
+        constexpr SpelledPitch tonicSpelling(int tonicPitchClass) const {
+            return TONICS.tonics[isMinor() ? 1 : 0][((tonicPitchClass % 12) + 12) % 12];
+        }
+
+        // One chord in the key on tonicPitchClass, given that key's tonic spelling
+        static constexpr Chord realize(const DegreeChord& degree, int tonicPitchClass, SpelledPitch tonic) {
+            int pitchClass = (tonicPitchClass + degree.offset) % 12;
+            auto spelling = SpelledPitch::onLetter(tonic.letter + degree.letterStep, pitchClass);
+            Note root(60 + pitchClass);
+            return spelling ? Chord(degree.type, root, *spelling) : Chord(degree.type, root);
+        }
+
+        // Writes the progression in one key to out, which must hold size() chords
+        void realizeInto(int tonicPitchClass, std::span<Chord> out) const {
+            tonicPitchClass = ((tonicPitchClass % 12) + 12) % 12;
+            SpelledPitch tonic = tonicSpelling(tonicPitchClass);
+            for (std::size_t i = 0; i < chords.size(); ++i) {
+                out[i] = realize(chords[i], tonicPitchClass, tonic);
+            }
+        }
+
+        // All 12 keys at once, key by key starting from C: out must hold 12 * size() chords
+        void realizeAllKeys(std::span<Chord> out) const {
+            for (int key = 0; key < 12; ++key) {
+                realizeInto(key, out.subspan(static_cast<std::size_t>(key) * chords.size(), chords.size()));
+            }
+        }
+
+        ChordProgression realize(int tonicPitchClass, const std::string& name) const {
+            std::vector<Chord> realized(chords.size(), Chord::major(Note(60)));
+            realizeInto(tonicPitchClass, realized);
+            std::vector<std::uint8_t> bassOffsets(chords.size());
+            for (std::size_t i = 0; i < chords.size(); ++i) bassOffsets[i] = chords[i].bassOffset;
+            return ChordProgression(name, std::move(realized), std::move(bassOffsets));
+        }
+};
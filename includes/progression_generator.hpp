@@ -0,0 +1,207 @@
+#pragma once
+
+#include "common.hpp"
+#include "catalog.hpp"
+#include "roman_numeral.hpp"
+#include "progression.hpp"
+#include <random>
+
+// Progressions for the generator to learn from, one list per mode. Each is
+// a loop, so the chord after the last is the first again.
+struct ProgressionCorpus {
+    static constexpr std::array<RomanProgression, 16> MAJOR = {
+        "I-V-vi-IV"_roman, "I-vi-IV-V"_roman, "vi-IV-I-V"_roman, "I-IV-vi-V"_roman,
+        "I-IV-I-V"_roman, "I-iii-IV-V"_roman, "I-IV-ii-V"_roman, "I-vi-ii-V7"_roman,
+        "ii7-V7-Imaj7-vi7"_roman, "Imaj7-vi7-ii7-V7"_roman, "iii7-vi7-ii7-V7"_roman, "I-bVII-IV-I"_roman,
+        "IV-V-iii-vi"_roman, "I-V-vi-iii-IV-I-IV-V"_roman, "Imaj7-IVmaj7-iii7-vi7-ii7-V7-Imaj7"_roman, "I-V7/vi-vi-IV-I-V7"_roman,
+    };
+
+    static constexpr std::array<RomanProgression, 10> MINOR = {
+        "i-iv-v"_roman, "i-VI-III-VII"_roman, "i-iv-V7-i"_roman, "i-VII-VI-V7"_roman,
+        "iiø7-V7-i"_roman, "i-VI-iv-V"_roman, "i-iv-VII-III"_roman, "i-III-VII-iv"_roman,
+        "VI-VII-i"_roman, "i-v-VI-III-iv-i-iv-V"_roman,
+    };
+
+    static std::vector<DegreeProgression> get(ScaleType mode) {
+        std::span<const RomanProgression> numerals = Key{mode, 0}.isMinor() ? std::span<const RomanProgression>(MINOR)
+                                                                             : std::span<const RomanProgression>(MAJOR);
+        std::vector<DegreeProgression> progressions;
+        for (const RomanProgression& progression : numerals) {
+            progressions.push_back(DegreeProgression::fromRomanNumerals(mode, progression));
+        }
+        return progressions;
+    }
+};
+
+// An order-n Markov chain over the chords of a corpus of degree
+// progressions. A state is the last n chords; its outgoing transitions sit
+// contiguously in one flat array as an alias table, each entry also naming
+// the state it leads to, so a generated chord costs one 64-bit random draw,
+// one or two adjacent array reads and no lookups. The tables are built
+// with integer arithmetic and sampled from std::mt19937_64, so a seed
+// gives the same progressions on every platform.
+class ProgressionGenerator {
+    public:
+        static constexpr std::size_t MAX_ORDER = 4;
+
+    private:
+        struct Entry {
+            std::uint32_t threshold; // Keep this column when the random low 32 bits fall below it
+            std::uint16_t token;     // Into vocabulary
+            std::uint16_t alias;     // Column to take otherwise, counted from the table's start
+            std::uint32_t next;      // State reached by emitting token (for the start table, the start state)
+        };
+
+        ScaleType mode = ScaleType::Major;
+        std::size_t order = 1;
+        std::vector<DegreeChord> vocabulary;
+        std::vector<std::array<std::uint16_t, MAX_ORDER>> contexts; // Each state's chords, oldest first
+        std::vector<std::uint32_t> offsets;                         // State s has entries[offsets[s] .. offsets[s + 1])
+        std::vector<Entry> entries;
+        std::vector<Entry> starts;                                  // Over states that open a corpus progression
+
+        // Vose's alias method on integer counts: every column ends up holding
+        // exactly total / n of the probability mass, split between itself and one alias
+        static void buildAlias(std::span<const std::uint32_t> counts, std::span<Entry> table) {
+            std::uint64_t n = counts.size(), total = 0;
+            for (std::uint32_t count : counts) total += count;
+
+            std::vector<std::uint64_t> scaled(counts.size());
+            std::vector<std::uint16_t> small, large;
+            for (std::size_t i = 0; i < counts.size(); ++i) {
+                scaled[i] = counts[i] * n;
+                (scaled[i] < total ? small : large).push_back(static_cast<std::uint16_t>(i));
+            }
+            while (!small.empty() && !large.empty()) {
+                std::uint16_t low = small.back(), high = large.back();
+                small.pop_back();
+                table[low].threshold = static_cast<std::uint32_t>((scaled[low] << 32) / total);
+                table[low].alias = high;
+                scaled[high] -= total - scaled[low];
+                if (scaled[high] < total) {
+                    large.pop_back();
+                    small.push_back(high);
+                }
+            }
+            // Whatever is left holds a full column, up to rounding
+            for (auto* rest : {&small, &large}) {
+                for (std::uint16_t i : *rest) {
+                    table[i].threshold = std::numeric_limits<std::uint32_t>::max();
+                    table[i].alias = i;
+                }
+            }
+        }
+
+        static std::uint32_t sample(std::span<const Entry> table, std::uint64_t random) {
+            auto column = static_cast<std::uint32_t>(((random >> 32) * table.size()) >> 32);
+            return static_cast<std::uint32_t>(random) < table[column].threshold ? column : table[column].alias;
+        }
+
+        static std::uint64_t pack(std::span<const std::uint16_t> tokens) {
+            std::uint64_t key = 0;
+            for (std::uint16_t token : tokens) key = key << 16 | token;
+            return key;
+        }
+
+    public:
+        ProgressionGenerator() = default;
+
+        // Learns from the corpus progressions in the given mode; the others are skipped
+        ProgressionGenerator(ScaleType generatorMode, std::span<const DegreeProgression> corpus, std::size_t chainOrder = 2)
+            : mode(generatorMode), order(std::clamp<std::size_t>(chainOrder, 1, MAX_ORDER)) {
+            // Chords to token ids, in order of first appearance
+            std::vector<std::vector<std::uint16_t>> sequences;
+            for (const DegreeProgression& progression : corpus) {
+                if (progression.getMode() != mode || progression.size() == 0) continue;
+                std::vector<std::uint16_t> tokens;
+                for (const DegreeChord& chord : progression.getChords()) {
+                    auto found = std::find(vocabulary.begin(), vocabulary.end(), chord);
+                    if (found == vocabulary.end()) found = vocabulary.insert(vocabulary.end(), chord);
+                    tokens.push_back(static_cast<std::uint16_t>(found - vocabulary.begin()));
+                }
+                sequences.push_back(std::move(tokens));
+            }
+
+            // Count every (context, next chord) pair around each loop
+            std::map<std::uint64_t, std::uint32_t> stateIds;
+            std::map<std::pair<std::uint32_t, std::uint16_t>, std::uint32_t> transitions;
+            std::map<std::uint32_t, std::uint32_t> startCounts;
+            auto contextAt = [&](const std::vector<std::uint16_t>& tokens, std::size_t begin) {
+                std::array<std::uint16_t, MAX_ORDER> context{};
+                for (std::size_t k = 0; k < order; ++k) context[k] = tokens[(begin + k) % tokens.size()];
+                return context;
+            };
+            auto stateOf = [&](const std::array<std::uint16_t, MAX_ORDER>& context) {
+                auto [it, inserted] = stateIds.try_emplace(pack(std::span(context).first(order)), static_cast<std::uint32_t>(contexts.size()));
+                if (inserted) contexts.push_back(context);
+                return it->second;
+            };
+            for (const auto& tokens : sequences) {
+                ++startCounts[stateOf(contextAt(tokens, 0))];
+                for (std::size_t i = 0; i < tokens.size(); ++i) {
+                    ++transitions[{stateOf(contextAt(tokens, i)), tokens[(i + order) % tokens.size()]}];
+                }
+            }
+
+            // Flatten into per-state alias tables; every successor state exists
+            // because it is the context one step further round the same loop
+            offsets.assign(contexts.size() + 1, 0);
+            for (const auto& [edge, count] : transitions) ++offsets[edge.first + 1];
+            for (std::size_t s = 1; s < offsets.size(); ++s) offsets[s] += offsets[s - 1];
+            entries.resize(transitions.size());
+
+            std::vector<std::uint32_t> counts;
+            auto edge = transitions.begin();
+            for (std::uint32_t state = 0; state < contexts.size(); ++state) {
+                counts.clear();
+                for (std::uint32_t e = offsets[state]; e < offsets[state + 1]; ++e, ++edge) {
+                    std::array<std::uint16_t, MAX_ORDER> successor{};
+                    std::copy_n(contexts[state].begin() + 1, order - 1, successor.begin());
+                    successor[order - 1] = edge->first.second;
+                    entries[e].token = edge->first.second;
+                    entries[e].next = stateIds.at(pack(std::span(successor).first(order)));
+                    counts.push_back(edge->second);
+                }
+                buildAlias(counts, std::span(entries).subspan(offsets[state], counts.size()));
+            }
+
+            counts.clear();
+            for (const auto& [state, count] : startCounts) {
+                starts.push_back(Entry{0, 0, 0, state});
+                counts.push_back(count);
+            }
+            buildAlias(counts, starts);
+        }
+
+        ScaleType getMode() const { return mode; }
+        std::size_t getOrder() const { return order; }
+        std::size_t stateCount() const { return contexts.size(); }
+        std::span<const DegreeChord> getVocabulary() const { return vocabulary; }
+        bool empty() const { return starts.empty(); }
+
+        // Fills out with one progression: an opening taken from the corpus,
+        // then each chord drawn given the ones before it
+        void generateInto(std::mt19937_64& engine, std::span<DegreeChord> out) const {
+            if (empty() || out.empty()) return;
+            std::uint32_t state = starts[sample(starts, engine())].next;
+            std::size_t i = 0;
+            for (; i < order && i < out.size(); ++i) out[i] = vocabulary[contexts[state][i]];
+            for (; i < out.size(); ++i) {
+                std::span<const Entry> table(entries.data() + offsets[state], offsets[state + 1] - offsets[state]);
+                const Entry& entry = table[sample(table, engine())];
+                out[i] = vocabulary[entry.token];
+                state = entry.next;
+            }
+        }
+
+        DegreeProgression generate(std::mt19937_64& engine, std::size_t length) const {
+            std::vector<DegreeChord> chords(empty() ? 0 : length);
+            generateInto(engine, chords);
+            return DegreeProgression(mode, std::move(chords));
+        }
+
+        DegreeProgression generate(std::uint64_t seed, std::size_t length) const {
+            std::mt19937_64 engine(seed);
+            return generate(engine, length);
+        }
+};
@@ -0,0 +1,395 @@
+#pragma once
+
+#include "common.hpp"
+#include "catalog.hpp"
+#include "pitch_class_set.hpp"
+#include "inline_list.hpp"
+#include "chord.hpp"
+#include "diatonic.hpp"
+#include "harmony_analyzer.hpp"
+#include "progression.hpp"
+#include <atomic>
+#include <barrier>
+#include <chrono>
+#include <thread>
+
+enum class Substitution : std::uint8_t {
+    Original,
+    TritoneSubstitution, // A dominant replaced by the dominant a tritone away: G7 -> Db7
+    SecondaryDominant,   // The dominant of the next chord, in place of or after this one
+    RelatedTwo,          // A dominant preceded by its own ii: G7 -> Dm7 G7
+    BackdoorTwoFive,     // iv7 bVII7 of the next chord's root: Fm7 Bb7 -> C
+    ModalInterchange,    // The chord on the same degree of the parallel key: F -> Fm in C
+    Count
+};
+
+constexpr std::string_view substitutionName(Substitution substitution) {
+    constexpr std::array<std::string_view, static_cast<std::size_t>(Substitution::Count)> NAMES = {
+        "Original", "Tritone substitution", "Secondary dominant", "Related ii", "Backdoor ii-V", "Modal interchange"
+    };
+    return NAMES[static_cast<std::size_t>(substitution)];
+}
+
+struct ReharmonizationOptions {
+    std::size_t beamWidth = 128; // Partial reharmonizations kept after each chord
+    std::size_t topK = 8;        // Results returned
+    unsigned threads = std::thread::hardware_concurrency(); // At most; narrow searches use fewer
+    std::chrono::milliseconds timeLimit{250}; // After this the remaining chords are left as they are
+    int melodyWeight = 2;     // How much a melody clash counts against a semitone of voice motion
+    int substitutionCost = 0; // Added per substituted chord, to favour lighter reharmonizations
+};
+
+struct ReharmonizedChord {
+    Chord chord;
+    std::uint32_t slot = 0; // Index of the original chord whose time it takes
+    Substitution substitution = Substitution::Original;
+};
+
+// Voice motion is paid in full at every chord change, however short the
+// chords; only melody clashes are shared out by time. cost is in half units
+// so a chord that takes half a slot can be charged half its clashes.
+struct Reharmonization {
+    std::vector<ReharmonizedChord> chords;
+    int cost = 0;         // 2 per semitone of motion, melodyWeight per clash per half slot, plus substitution costs
+    int voiceLeading = 0; // Semitones of pitch-class motion between consecutive chords
+    int melody = 0;       // Melody clashes under each chord, counted per half slot it sounds
+    int substitutions = 0;
+    bool truncated = false; // The time limit ran out and later chords were not searched
+};
+
+// Beam search over substitutions, one original chord (a slot) at a time.
+// Every slot offers the original chord plus whichever substitutions apply
+// there; a partial reharmonization pays the voice motion into each chord
+// and the melody notes that clash with it. A dominant aimed at the next
+// chord is only kept if the next slot starts with that chord. When a step has enough nodes to
+// pay for it, the beam is split across worker threads that prune to their
+// own best beamWidth before a barrier merges them, so the result does not
+// depend on the thread count. Smaller searches run on the calling thread.
+// Voice-leading costs between chord pairs are memoized in a lock-free
+// table shared by all threads and all searches.
+class Reharmonizer {
+    private:
+        static constexpr std::size_t CHORD_COUNT = FormulaCatalog::CHORDS.size() * 12;
+        static constexpr std::uint16_t NO_CHORD = std::numeric_limits<std::uint16_t>::max();
+        static constexpr int REPEAT_COST = 4; // Motion charged for a chord followed by itself, which goes nowhere
+        static constexpr std::size_t PARALLEL_GRAIN = 8192; // Nodes per step each worker thread needs to beat the barrier
+
+        // A chord as a dense id: quality * 12 + root pitch class
+        static constexpr std::uint16_t idOf(ChordType type, int root) {
+            return static_cast<std::uint16_t>(static_cast<int>(type) * 12 + ((root % 12) + 12) % 12);
+        }
+        static constexpr ChordType typeOf(std::uint16_t id) { return static_cast<ChordType>(id / 12); }
+        static constexpr int rootOf(std::uint16_t id) { return id % 12; }
+        static constexpr PitchClassSet tonesOf(std::uint16_t id) {
+            return PitchClassSet(FormulaCatalog::get(typeOf(id)).mask).transpose(rootOf(id));
+        }
+
+        // A chord of a segment with the spelling of its root
+        struct Part {
+            std::uint16_t id;
+            SpelledPitch root;
+        };
+
+        struct Segment {
+            InlineList<std::uint16_t, 2> chords;
+            InlineList<SpelledPitch, 2> roots;
+            Substitution substitution = Substitution::Original;
+            std::uint16_t resolvesTo = NO_CHORD; // The chord the next slot must start with, for a dominant aimed at it
+        };
+
+        struct Node {
+            int cost = 0;
+            int voiceLeading = 0;
+            int melody = 0;
+            std::uint32_t parent = 0;
+            std::uint32_t substitutions = 0; // Up to one per slot, so as wide as a slot index
+            std::uint16_t last = NO_CHORD;
+            std::uint16_t expects = NO_CHORD; // Set while a secondary or backdoor dominant waits for its target
+            std::uint8_t choice = 0;
+        };
+
+        // A strict total order, so the beam kept is the same however the work was split
+        static bool ranksBefore(const Node& a, const Node& b) {
+            if (a.cost != b.cost) return a.cost < b.cost;
+            if (a.parent != b.parent) return a.parent < b.parent;
+            return a.choice < b.choice;
+        }
+
+        static void keepBest(std::vector<Node>& nodes, std::size_t count) {
+            if (nodes.size() <= count) return;
+            std::nth_element(nodes.begin(), nodes.begin() + static_cast<std::ptrdiff_t>(count), nodes.end(), ranksBefore);
+            nodes.resize(count);
+        }
+
+        std::unique_ptr<std::atomic<std::int16_t>[]> motionCache; // -1 until computed
+        std::vector<std::array<std::uint8_t, 12>> clashes;        // Per chord id and melody pitch class
+
+        // Each tone moves to the nearest tone of the other chord, counted in
+        // whichever direction costs more, as VoiceLeadingSolver does for voicings
+        static int computeMotion(std::uint16_t from, std::uint16_t to) {
+            auto oneWay = [](PitchClassSet a, PitchClassSet b) {
+                int total = 0;
+                a.forEach([&](int pc) {
+                    int nearest = 6;
+                    b.forEach([&](int other) { nearest = std::min(nearest, std::min((pc - other + 12) % 12, (other - pc + 12) % 12)); });
+                    total += nearest;
+                });
+                return total;
+            };
+            return std::max(oneWay(tonesOf(from), tonesOf(to)), oneWay(tonesOf(to), tonesOf(from)));
+        }
+
+        int motion(std::uint16_t from, std::uint16_t to) const {
+            if (from == NO_CHORD) return 0;
+            if (from == to) return REPEAT_COST;
+            std::atomic<std::int16_t>& slot = motionCache[static_cast<std::size_t>(from) * CHORD_COUNT + to];
+            std::int16_t cached = slot.load(std::memory_order_relaxed);
+            if (cached < 0) {
+                cached = static_cast<std::int16_t>(computeMotion(from, to));
+                slot.store(cached, std::memory_order_relaxed);
+            }
+            return cached;
+        }
+
+        // How badly a melody note sits over a chord: 0 for a chord tone, 1
+        // for an available tension, more for an avoid note
+        static std::uint8_t computeClash(std::uint16_t id, int pitchClass) {
+            PitchClassSet tones(FormulaCatalog::get(typeOf(id)).mask);
+            int interval = (pitchClass - rootOf(id) + 12) % 12;
+            if (tones.contains(interval)) return 0;
+            bool majorThird = tones.contains(4);
+            bool dominant = majorThird && tones.contains(10);
+            switch (interval) {
+                case 2: case 9: return 1;
+                case 5: return majorThird ? 4 : 1;
+                case 6: return dominant ? 1 : 3;
+                case 1: case 3: case 8: return dominant ? 2 : 4;
+                default: return 3;
+            }
+        }
+
+        int clash(std::uint16_t id, PitchClassSet melody) const {
+            int total = 0;
+            melody.forEach([&](int pc) { total += clashes[id][pc]; });
+            return total;
+        }
+
+        static bool isDominant(std::uint16_t id) {
+            PitchClassSet tones(FormulaCatalog::get(typeOf(id)).mask);
+            return tones.contains(4) && tones.contains(10) && !tones.contains(11);
+        }
+
+        // A chord rooted the given number of letters above a spelled pitch,
+        // so a tritone substitute for G7 is Db7 rather than C#7. Roots that
+        // would need a double accidental, such as Ebb, take the plain spelling.
+        static Part spelledOn(ChordType type, SpelledPitch from, int letters, int pitchClass) {
+            std::uint16_t id = idOf(type, pitchClass);
+            auto root = SpelledPitch::onLetter(from.letter + letters, rootOf(id));
+            if (root && std::abs(root->accidental) <= 1) return Part{id, *root};
+            return Part{id, Chord(type, Note(60 + rootOf(id))).getRootSpelling()};
+        }
+
+        // Every distinct segment that can take the time of chord i
+        static std::vector<Segment> candidates(std::span<const Chord> chords, std::size_t i, const Key& key) {
+            Part current{idOf(chords[i].getType(), chords[i].getRoot().getPitchClass()), chords[i].getRootSpelling()};
+            std::vector<Segment> segments;
+            auto add = [&](Substitution substitution, std::initializer_list<Part> parts, std::uint16_t resolvesTo = NO_CHORD) {
+                Segment segment{{}, {}, substitution, resolvesTo};
+                for (const Part& part : parts) {
+                    segment.chords.push_back(part.id);
+                    segment.roots.push_back(part.root);
+                }
+                bool seen = std::any_of(segments.begin(), segments.end(), [&](const Segment& other) {
+                    return other.chords == segment.chords;
+                });
+                if (!seen) segments.push_back(segment);
+            };
+
+            add(Substitution::Original, {current});
+            int root = rootOf(current.id);
+            if (isDominant(current.id)) {
+                // bII of the chord it resolves to, and the ii of its own key
+                // unless that ii is already the chord before
+                add(Substitution::TritoneSubstitution, {spelledOn(typeOf(current.id), current.root, 4, root + 6)});
+                Part two = spelledOn(ChordType::Minor7, current.root, 4, root + 7);
+                if (i == 0 || idOf(chords[i - 1].getType(), chords[i - 1].getRoot().getPitchClass()) != two.id) {
+                    add(Substitution::RelatedTwo, {two, current});
+                }
+            }
+
+            if (i + 1 < chords.size()) {
+                SpelledPitch next = chords[i + 1].getRootSpelling();
+                int target = chords[i + 1].getRoot().getPitchClass();
+                std::uint16_t nextId = idOf(chords[i + 1].getType(), target);
+                // V of the next chord, and the iv and bVII of its key for the
+                // backdoor; both only resolve if the next chord is kept
+                Part dominant = spelledOn(ChordType::Dominant7, next, 4, target + 7);
+                if (dominant.id != current.id) {
+                    add(Substitution::SecondaryDominant, {dominant}, nextId);
+                    add(Substitution::SecondaryDominant, {current, dominant}, nextId);
+                }
+                PitchClassSet nextTones(FormulaCatalog::get(chords[i + 1].getType()).mask);
+                if (nextTones.contains(4) && nextTones.contains(7) && !nextTones.contains(10)) {
+                    Part backdoor = spelledOn(ChordType::Dominant7, next, 6, target + 10);
+                    add(Substitution::BackdoorTwoFive, {backdoor}, nextId);
+                    add(Substitution::BackdoorTwoFive, {spelledOn(ChordType::Minor7, next, 3, target + 5), backdoor}, nextId);
+                }
+            }
+
+            // The parallel key's chord on the same degree, with as many tones as the original
+            ScaleType mode = key.isMinor() ? ScaleType::Minor : ScaleType::Major;
+            ScaleType parallel = key.isMinor() ? ScaleType::Major : ScaleType::Minor;
+            if (auto degree = HarmonicReadingTable::degreeAt(mode, (root - key.tonic + 12) % 12)) {
+                const DiatonicChord& borrowed = DiatonicHarmony::get(parallel, *degree);
+                auto type = chords[i].getIntervals().size() >= 3 ? borrowed.seventh : borrowed.triad;
+                if (type) {
+                    int pitchClass = key.tonic + HarmonicReadingTable::position(parallel, *degree);
+                    add(Substitution::ModalInterchange, {spelledOn(*type, Speller::tonic(key), *degree, pitchClass)});
+                }
+            }
+            return segments;
+        }
+
+    public:
+        Reharmonizer() : motionCache(new std::atomic<std::int16_t>[CHORD_COUNT * CHORD_COUNT]), clashes(CHORD_COUNT) {
+            for (std::size_t i = 0; i < CHORD_COUNT * CHORD_COUNT; ++i) motionCache[i].store(-1, std::memory_order_relaxed);
+            for (std::uint16_t id = 0; id < CHORD_COUNT; ++id) {
+                for (int pc = 0; pc < 12; ++pc) clashes[id][pc] = computeClash(id, pc);
+            }
+        }
+
+        static const Reharmonizer& instance() {
+            static const Reharmonizer reharmonizer;
+            return reharmonizer;
+        }
+
+        // The semitones of voice motion search charges for moving from one chord to the next
+        int voiceMotion(const Chord& from, const Chord& to) const {
+            return motion(idOf(from.getType(), from.getRoot().getPitchClass()), idOf(to.getType(), to.getRoot().getPitchClass()));
+        }
+
+        // The topK best reharmonizations that change at least one chord, best
+        // first. melody holds the melody notes over each chord; one of any
+        // other length than chords is ignored.
+        std::vector<Reharmonization> search(std::span<const Chord> chords, std::span<const PitchClassSet> melody = {},
+                                            const ReharmonizationOptions& options = {}) const {
+            if (chords.empty()) return {};
+            if (melody.size() != chords.size()) melody = {};
+            auto deadline = std::chrono::steady_clock::now() + options.timeLimit;
+            std::size_t beamWidth = std::max<std::size_t>(options.beamWidth, 1);
+
+            HarmonicAnalysis analysis = HarmonicAnalyzer::analyze(chords);
+            std::vector<std::vector<Segment>> slots(chords.size());
+            for (std::size_t i = 0; i < chords.size(); ++i) slots[i] = candidates(chords, i, analysis.chords[i].key);
+
+            // layers[s] holds the beam after s chords; layers[0] is the empty start
+            std::vector<std::vector<Node>> layers(chords.size() + 1);
+            layers[0].push_back(Node{});
+            std::size_t step = 0;
+            bool truncated = false;
+
+            // One thread per PARALLEL_GRAIN nodes of the widest step, up to the requested count
+            std::size_t widest = 0;
+            for (const auto& segments : slots) widest = std::max(widest, segments.size());
+            std::size_t grains = beamWidth * widest / PARALLEL_GRAIN;
+            unsigned threadCount = static_cast<unsigned>(std::clamp<std::size_t>(grains, 1, std::max(options.threads, 1u)));
+            std::vector<std::vector<Node>> local(threadCount);
+            auto merge = [&]() noexcept {
+                std::vector<Node>& next = layers[step + 1];
+                for (auto& part : local) {
+                    next.insert(next.end(), part.begin(), part.end());
+                    part.clear();
+                }
+                keepBest(next, beamWidth);
+                std::sort(next.begin(), next.end(), ranksBefore);
+                ++step;
+                truncated = truncated || (step < chords.size() && std::chrono::steady_clock::now() > deadline);
+            };
+            std::barrier sync(static_cast<std::ptrdiff_t>(threadCount), merge);
+
+            auto worker = [&](unsigned t) {
+                while (step < chords.size()) {
+                    const std::vector<Node>& beam = layers[step];
+                    const std::vector<Segment>& segments = slots[step];
+                    // Past the deadline only the original chord is tried
+                    std::size_t choices = truncated ? 1 : segments.size();
+                    std::vector<Node>& out = local[t];
+                    for (std::size_t b = t; b < beam.size(); b += threadCount) {
+                        const Node& parent = beam[b];
+                        for (std::size_t c = 0; c < choices; ++c) {
+                            const Segment& segment = segments[c];
+                            // A pending dominant must be followed by the chord it
+                            // resolves to, and an inserted ii by a chord other than itself
+                            if (parent.expects != NO_CHORD && segment.chords[0] != parent.expects) continue;
+                            if (segment.substitution == Substitution::RelatedTwo && segment.chords[0] == parent.last) continue;
+                            Node child;
+                            child.parent = static_cast<std::uint32_t>(b);
+                            child.choice = static_cast<std::uint8_t>(c);
+                            child.last = segment.chords.back();
+                            child.expects = segment.resolvesTo;
+                            child.substitutions = parent.substitutions + (segment.substitution != Substitution::Original);
+
+                            // Every chord change moves the voices in full; the melody is shared out by time
+                            int voiceLeading = motion(parent.last, segment.chords[0]);
+                            if (segment.chords.size() == 2) voiceLeading += motion(segment.chords[0], segment.chords[1]);
+                            int share = segment.chords.size() == 1 ? 2 : 1;
+                            int clashing = 0;
+                            if (!melody.empty()) {
+                                for (std::uint16_t id : segment.chords) clashing += share * clash(id, melody[step]);
+                            }
+                            child.voiceLeading = parent.voiceLeading + voiceLeading;
+                            child.melody = parent.melody + clashing;
+                            child.cost = parent.cost + 2 * voiceLeading + options.melodyWeight * clashing +
+                                         2 * options.substitutionCost * (segment.substitution != Substitution::Original);
+                            out.push_back(child);
+                        }
+                        // The global best beamWidth are among each thread's own best beamWidth
+                        if (out.size() >= 2 * beamWidth) keepBest(out, beamWidth);
+                    }
+                    sync.arrive_and_wait();
+                }
+            };
+
+            std::vector<std::thread> workers;
+            for (unsigned t = 1; t < threadCount; ++t) workers.emplace_back(worker, t);
+            worker(0);
+            for (std::thread& thread : workers) thread.join();
+
+            std::vector<Reharmonization> results;
+            const std::vector<Node>& finals = layers.back();
+            for (std::size_t f = 0; f < finals.size() && results.size() < options.topK; ++f) {
+                if (finals[f].substitutions == 0) continue;
+                Reharmonization result;
+                result.cost = finals[f].cost;
+                result.voiceLeading = finals[f].voiceLeading;
+                result.melody = finals[f].melody;
+                result.substitutions = static_cast<int>(finals[f].substitutions);
+                result.truncated = truncated;
+
+                std::vector<std::uint8_t> choices(chords.size());
+                std::uint32_t index = static_cast<std::uint32_t>(f);
+                for (std::size_t s = chords.size(); s > 0; --s) {
+                    choices[s - 1] = layers[s][index].choice;
+                    index = layers[s][index].parent;
+                }
+                for (std::size_t s = 0; s < chords.size(); ++s) {
+                    const Segment& segment = slots[s][choices[s]];
+                    for (std::size_t k = 0; k < segment.chords.size(); ++k) {
+                        // Only the chords a substitution brings in are tagged with it
+                        std::uint16_t id = segment.chords[k];
+                        bool kept = id == idOf(chords[s].getType(), chords[s].getRoot().getPitchClass());
+                        Chord chord = kept ? chords[s] : Chord(typeOf(id), Note(60 + rootOf(id)), segment.roots[k]);
+                        Substitution substitution = kept ? Substitution::Original : segment.substitution;
+                        result.chords.push_back(ReharmonizedChord{chord, static_cast<std::uint32_t>(s), substitution});
+                    }
+                }
+                results.push_back(std::move(result));
+            }
+            return results;
+        }
+
+        std::vector<Reharmonization> search(const ChordProgression& progression, std::span<const PitchClassSet> melody = {},
+                                            const ReharmonizationOptions& options = {}) const {
+            return search(progression.getChords(), melody, options);
+        }
+};
@@ -0,0 +1,282 @@
+#pragma once
+
+#include "common.hpp"
+#include "catalog.hpp"
+#include "inline_list.hpp"
+#include "scale.hpp"
+#include "chord.hpp"
+#include "diatonic.hpp"
+#include <cstdlib>
+
+// A scale degree as written in a numeral: an optional chromatic alteration
+// (bVII, #iv) and upper case for a major chord, lower case for a minor one
+struct RomanDegree {
+    static constexpr std::array<std::string_view, 7> UPPER = {"I", "II", "III", "IV", "V", "VI", "VII"};
+    static constexpr std::array<std::string_view, 7> LOWER = {"i", "ii", "iii", "iv", "v", "vi", "vii"};
+
+    std::int8_t degree = 0;     // 0-based, I = 0 .. VII = 6
+    std::int8_t alteration = 0; // Semitones, -1 per b and +1 per #
+    bool upper = true;
+
+    std::string getName() const {
+        std::string name(static_cast<std::size_t>(std::abs(alteration)), alteration < 0 ? 'b' : '#');
+        name += upper ? UPPER[degree] : LOWER[degree];
+        return name;
+    }
+
+    constexpr bool operator==(const RomanDegree&) const = default;
+};
+
+enum class NumeralMarker : std::uint8_t {
+    None,
+    Diminished,     // ° or o
+    HalfDiminished, // ø, which implies a seventh
+    Augmented       // +
+};
+
+enum class NumeralExtension : std::uint8_t {
+    None,
+    Seventh,     // 7 and the inversion figures 65, 43, 42
+    MajorSeventh // maj7 or M7
+};
+
+// One parsed numeral such as "V65/V", "bVII", "viiø7" or "ii6"
+struct RomanNumeral {
+    RomanDegree root;
+    NumeralMarker marker = NumeralMarker::None;
+    NumeralExtension extension = NumeralExtension::None;
+    std::uint8_t inversion = 0;         // 0 = root position, from figures such as 6, 64, 65, 43, 42
+    InlineList<RomanDegree, 3> targets; // Secondary function targets, outermost last: V/V/ii is {V, ii}
+
+    // Markers decide outright. Otherwise a plain numeral takes the scale's
+    // own triad on that degree when its case agrees (vii in major is
+    // diminished, III in harmonic minor augmented) and a plain major or
+    // minor triad when it doesn't (IV borrowed into a minor key).
+    constexpr ChordType triadType(ScaleType context) const {
+        switch (marker) {
+            case NumeralMarker::Diminished:
+            case NumeralMarker::HalfDiminished:
+                return ChordType::Diminished;
+            case NumeralMarker::Augmented:
+                return ChordType::Augmented;
+            case NumeralMarker::None:
+                break;
+        }
+        if (root.alteration == 0) {
+            auto diatonic = DiatonicHarmony::get(context, root.degree).triad;
+            bool diatonicUpper = diatonic == ChordType::Major || diatonic == ChordType::Augmented;
+            if (diatonic && diatonicUpper == root.upper) return *diatonic;
+        }
+        return root.upper ? ChordType::Major : ChordType::Minor;
+    }
+
+    // Case and markers give the triad. A plain 7 without a marker takes the
+    // scale's own seventh on that degree when its triad agrees (IV7 in major
+    // is a major 7th, vii7 a half-diminished 7th); an explicit ° or + and a
+    // chromatic degree take the fully diminished or augmented dominant 7th,
+    // and anything else the usual dominant or minor seventh
+    constexpr ChordType chordType(ScaleType context) const {
+        ChordType triad = triadType(context);
+        if (marker == NumeralMarker::HalfDiminished) return ChordType::HalfDiminished7;
+
+        switch (extension) {
+            case NumeralExtension::None:
+                return triad;
+            case NumeralExtension::MajorSeventh:
+                if (triad == ChordType::Augmented) return ChordType::AugmentedMajor7;
+                return triad == ChordType::Major ? ChordType::Major7 : ChordType::MinorMajor7;
+            case NumeralExtension::Seventh:
+                break;
+        }
+
+        if (marker == NumeralMarker::None && root.alteration == 0) {
+            const DiatonicChord& diatonic = DiatonicHarmony::get(context, root.degree);
+            if (diatonic.triad == triad && diatonic.seventh) return *diatonic.seventh;
+        }
+        if (triad == ChordType::Diminished) return ChordType::Diminished7;
+        if (triad == ChordType::Augmented) return ChordType::Dominant7Sharp5;
+        return triad == ChordType::Major ? ChordType::Dominant7 : ChordType::Minor7;
+    }
+
+    // The chord this numeral names in a scale, spelled in the key it lives
+    // in, with its root in the octave above the scale's root
+    constexpr Chord realize(const Scale& scale) const {
+        int home = scale.getRoot().getMidiValue();
+        auto inHomeOctave = [home](Note note) { return Note(home + ((note.getMidiValue() - home) % 12 + 12) % 12); };
+
+        // Tonicize each target in turn, starting from the one nearest the home key
+        Scale context = scale;
+        for (std::size_t i = targets.size(); i-- > 0;) {
+            const RomanDegree& target = targets[i];
+            Note tonic = inHomeOctave(context.getDegree(target.degree).transpose(target.alteration));
+            context = Scale(target.upper ? ScaleType::Major : ScaleType::Minor, tonic);
+        }
+
+        Note rootNote = inHomeOctave(context.getDegree(root.degree).transpose(root.alteration));
+        return Chord(chordType(context.getType()), rootNote).spelledIn(context.getKey());
+    }
+
+    // Semitones from the chord root up to the bass note the inversion figure asks for
+    constexpr int bassOffset(const Chord& chord) const {
+        auto intervals = chord.getIntervals();
+        return inversion == 0 || inversion > intervals.size() ? 0 : intervals[inversion - 1];
+    }
+
+    // Written out the way RomanNumeralParser reads it, e.g. "V65/V", "bVII" or "viiø7"
+    std::string getName() const {
+        constexpr std::array<std::string_view, 3> TRIAD_FIGURES = {"", "6", "64"};
+        constexpr std::array<std::string_view, 4> SEVENTH_FIGURES = {"7", "65", "43", "42"};
+
+        std::string name = root.getName();
+        switch (marker) {
+            case NumeralMarker::None: break;
+            case NumeralMarker::Diminished: name += "°"; break;
+            case NumeralMarker::HalfDiminished: name += "ø"; break;
+            case NumeralMarker::Augmented: name += "+"; break;
+        }
+        switch (extension) {
+            case NumeralExtension::None: name += TRIAD_FIGURES[std::min<std::size_t>(inversion, 2)]; break;
+            case NumeralExtension::Seventh: name += SEVENTH_FIGURES[std::min<std::size_t>(inversion, 3)]; break;
+            case NumeralExtension::MajorSeventh: name += "maj7"; break;
+        }
+        for (const RomanDegree& target : targets) name += "/" + target.getName();
+        return name;
+    }
+};
+
+// Parses Roman numeral chord symbols out of a string_view. Grammar:
+//   numeral   := degree marker? figure? ("/" degree)*
+//   degree    := ("b" | "#")* ("I" .. "VII" | "i" .. "vii")
+//   marker    := "°" | "o" | "ø" | "+"
+//   figure    := "7" | "maj7" | "M7" | "6" | "64" | "65" | "43" | "42" | "2"
+// Nothing allocates; malformed input yields std::nullopt.
+class RomanNumeralParser {
+    private:
+        struct Figure {
+            std::string_view text;
+            NumeralExtension extension;
+            std::uint8_t inversion;
+        };
+
+        // Longest first so "65" is not read as "6"
+        static constexpr std::array<Figure, 9> FIGURES = {{
+            {"maj7", NumeralExtension::MajorSeventh, 0},
+            {"M7", NumeralExtension::MajorSeventh, 0},
+            {"65", NumeralExtension::Seventh, 1},
+            {"43", NumeralExtension::Seventh, 2},
+            {"42", NumeralExtension::Seventh, 3},
+            {"64", NumeralExtension::None, 2},
+            {"7", NumeralExtension::Seventh, 0},
+            {"6", NumeralExtension::None, 1},
+            {"2", NumeralExtension::Seventh, 3},
+        }};
+
+        // Reads a degree from the front of text and removes it
+        static constexpr std::optional<RomanDegree> parseDegree(std::string_view& text) {
+            RomanDegree degree;
+            while (!text.empty() && (text[0] == 'b' || text[0] == '#')) {
+                degree.alteration = static_cast<std::int8_t>(degree.alteration + (text[0] == '#' ? 1 : -1));
+                text.remove_prefix(1);
+            }
+
+            // The longest numeral that matches, so "VII" wins over "V" and "IV" over "I"
+            std::size_t matched = 0;
+            for (std::size_t i = 0; i < RomanDegree::UPPER.size(); ++i) {
+                for (bool upper : {true, false}) {
+                    std::string_view numeral = upper ? RomanDegree::UPPER[i] : RomanDegree::LOWER[i];
+                    if (numeral.size() > matched && text.starts_with(numeral)) {
+                        matched = numeral.size();
+                        degree.degree = static_cast<std::int8_t>(i);
+                        degree.upper = upper;
+                    }
+                }
+            }
+            if (matched == 0) return std::nullopt;
+            text.remove_prefix(matched);
+            return degree;
+        }
+
+    public:
+        static constexpr std::optional<RomanNumeral> parse(std::string_view text) {
+            RomanNumeral numeral;
+            auto root = parseDegree(text);
+            if (!root) return std::nullopt;
+            numeral.root = *root;
+
+            if (text.starts_with("°") || text.starts_with("o")) {
+                numeral.marker = NumeralMarker::Diminished;
+                text.remove_prefix(text.starts_with("o") ? 1 : std::string_view("°").size());
+            } else if (text.starts_with("ø")) {
+                numeral.marker = NumeralMarker::HalfDiminished;
+                numeral.extension = NumeralExtension::Seventh;
+                text.remove_prefix(std::string_view("ø").size());
+            } else if (text.starts_with("+")) {
+                numeral.marker = NumeralMarker::Augmented;
+                text.remove_prefix(1);
+            }
+
+            for (const Figure& figure : FIGURES) {
+                if (text.starts_with(figure.text)) {
+                    if (figure.extension != NumeralExtension::None) numeral.extension = figure.extension;
+                    numeral.inversion = figure.inversion;
+                    text.remove_prefix(figure.text.size());
+                    break;
+                }
+            }
+
+            while (text.starts_with("/")) {
+                text.remove_prefix(1);
+                auto target = parseDegree(text);
+                if (!target || numeral.targets.full()) return std::nullopt;
+                numeral.targets.push_back(*target);
+            }
+
+            if (!text.empty()) return std::nullopt;
+            return numeral;
+        }
+
+        // Splits a progression such as "ii7-V7-I" or "I | vi | IV | V" into
+        // numerals; nullopt if any of them fails to parse or there are too many
+        template <std::size_t Capacity>
+        static constexpr std::optional<InlineList<RomanNumeral, Capacity>> parseProgression(std::string_view text) {
+            constexpr std::string_view SEPARATORS = " -|,";
+            InlineList<RomanNumeral, Capacity> numerals;
+            while (true) {
+                std::size_t start = text.find_first_not_of(SEPARATORS);
+                if (start == std::string_view::npos) break;
+                text.remove_prefix(start);
+                std::size_t end = std::min(text.find_first_of(SEPARATORS), text.size());
+                auto numeral = parse(text.substr(0, end));
+                if (!numeral || numerals.full()) return std::nullopt;
+                numerals.push_back(*numeral);
+                text.remove_prefix(end);
+            }
+            return numerals;
+        }
+};
+
+// A progression parsed at compile time by the _roman literal
+using RomanProgression = InlineList<RomanNumeral, 16>;
+
+// "ii7-V7-I"_roman: a malformed numeral is a compile error, not a runtime one
+consteval RomanProgression operator""_roman(const char* text, std::size_t length) {
+    auto progression = RomanNumeralParser::parseProgression<16>(std::string_view(text, length));
+    if (!progression) throw "invalid Roman numeral progression";
+    return *progression;
+}
+
+static_assert(RomanNumeralParser::parse("vii")->realize(Scale::majorScale(Note(60))).getType() == ChordType::Diminished);
+static_assert(RomanNumeralParser::parse("IV")->realize(Scale::minorScale(Note(60))).getType() == ChordType::Major);
+static_assert(RomanNumeralParser::parse("vii°")->realize(Scale::majorScale(Note(60))).getType() == ChordType::Diminished);
+static_assert(RomanNumeralParser::parse("IV7")->realize(Scale::majorScale(Note(60))).getType() == ChordType::Major7);
+static_assert(RomanNumeralParser::parse("V7/V")->realize(Scale::majorScale(Note(60))).getRoot() == Note(62));
+static_assert(RomanNumeralParser::parse("bVII")->realize(Scale::majorScale(Note(60))).getRootSpelling().getName() == "Bb");
+static_assert(RomanNumeralParser::parse("V65")->inversion == 1);
+static_assert(RomanNumeralParser::parse("vii7")->chordType(ScaleType::Major) == ChordType::HalfDiminished7);
+static_assert(RomanNumeralParser::parse("ii7")->chordType(ScaleType::Minor) == ChordType::HalfDiminished7);
+static_assert(RomanNumeralParser::parse("III7")->chordType(ScaleType::HarmonicMinor) == ChordType::AugmentedMajor7);
+static_assert(RomanNumeralParser::parse("vii°7")->chordType(ScaleType::Major) == ChordType::Diminished7);
+static_assert(RomanNumeralParser::parse("viiø7")->realize(Scale::majorScale(Note(60))).getType() == ChordType::HalfDiminished7);
+static_assert(!RomanNumeralParser::parse("VIII"));
+static_assert(!RomanNumeralParser::parse("V/"));
+static_assert("ii7-V7-I"_roman.size() == 3);
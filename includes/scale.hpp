@@ -0,0 +1,84 @@
+#pragma once
+
+#include "common.hpp"
+#include "note.hpp"
+#include "pitch_class_set.hpp"
+#include "catalog.hpp"
+#include "spelling.hpp"
+#include "scale_view.hpp"
+#include "mode.hpp"
+
+class Scale {
+    private:
+        ScaleType type;
+        Note rootNote;
+
+    public:
+        constexpr Scale(ScaleType scaleType, const Note& root) : type(scaleType), rootNote(root) {}
+        
+        constexpr ScaleType getType() const { return type; }
+        constexpr Note getRoot() const { return rootNote; }
+        constexpr const ScaleFormula& getFormula() const { return FormulaCatalog::get(type); }
+        
+        // Semitones between consecutive degrees, viewed straight out of the catalog
+        constexpr std::span<const std::uint8_t> getIntervals() const { return getFormula().getSteps(); }
+        
+        constexpr Key getKey() const { return Key{type, static_cast<std::uint8_t>(rootNote.getPitchClass())}; }
+        
+        // Spelling of any pitch class in the context of this scale's key
+        constexpr SpelledPitch spell(int pitchClass) const { return Speller::spell(getKey(), pitchClass); }
+        
+        std::string getName() const {
+            return std::string(spell(rootNote.getPitchClass()).getName()) + " " + std::string(getFormula().name);
+        }
+        
+        // Lazily walks the scale's notes between two MIDI values, inclusive
+        constexpr ScaleView view(int lowMidi, int highMidi, Direction direction = Direction::Ascending) const {
+            return ScaleView(getPitchClassSet(), lowMidi, highMidi, direction);
+        }
+        
+        // One octave from the root up to and including the octave above it
+        constexpr ScaleView octave() const {
+            return view(rootNote.getMidiValue(), rootNote.getMidiValue() + 12);
+        }
+        
+        // Every rotation of this scale, starting with the scale itself
+        constexpr ModeRange modes() const { return ModeRange(PitchClassSet(getFormula().mask), rootNote); }
+        
+        // The note on a 0-based scale degree above the root; degrees past the
+        // last step carry on into higher octaves
+        constexpr Note getDegree(int degree) const {
+            auto steps = getIntervals();
+            int size = static_cast<int>(steps.size());
+            int position = rootNote.getMidiValue() + 12 * (degree / size);
+            for (int i = 0; i < degree % size; ++i) {
+                position += steps[i];
+            }
+            return Note(position);
+        }
+        
+        constexpr PitchClassSet getPitchClassSet() const {
+            return PitchClassSet(getFormula().mask).transpose(rootNote.getPitchClass());
+        }
+        
+        void print() const {
+            std::cout << getName() << " Scale: ";
+            for (Note note : octave()) {
+                std::cout << spell(note.getPitchClass()).getName() << " ";
+            }
+            std::cout << std::endl;
+        }
+        
+        static constexpr Scale majorScale(const Note& root) { return Scale(ScaleType::Major, root); }
+        static constexpr Scale minorScale(const Note& root) { return Scale(ScaleType::Minor, root); }
+        static constexpr Scale harmonicMinor(const Note& root) { return Scale(ScaleType::HarmonicMinor, root); }
+        static constexpr Scale melodicMinor(const Note& root) { return Scale(ScaleType::MelodicMinor, root); }
+        static constexpr Scale pentatonicMajor(const Note& root) { return Scale(ScaleType::PentatonicMajor, root); }
+        static constexpr Scale pentatonicMinor(const Note& root) { return Scale(ScaleType::PentatonicMinor, root); }
+        static constexpr Scale bluesScale(const Note& root) { return Scale(ScaleType::Blues, root); }
+};
+
+static_assert(std::is_trivially_copyable_v<Scale>);
+static_assert(Scale::majorScale(Note(65)).spell(10).getName() == "Bb");
+static_assert(Scale::minorScale(Note(57)).getDegree(9) == Note(72));
+static_assert(Scale::majorScale(Note(62)).getPitchClassSet() == PitchClassSet::fromPitchClasses({2, 4, 6, 7, 9, 11, 1}));
@@ -0,0 +1,231 @@
+#pragma once
+
+#include "common.hpp"
+#include "pitch_class_set.hpp"
+
+// One row of the exhaustive catalog, describing a pitch-class set read as a
+// scale rooted on pitch class 0 (sets without 0 are read from their lowest
+// member).
+struct ScaleEntry {
+    std::uint64_t steps = 0;          // Semitones between consecutive degrees, 4 bits each, first degree lowest
+    std::uint32_t intervalVector = 0; // Counts of interval classes 1..6, 4 bits each, ic1 lowest
+    std::uint16_t modeFamily = 0;     // Most compact rotation (normal form); every mode of a scale shares it
+    std::uint16_t modeParent = 0;     // Rotation that counts as mode 1: the first-listed named one, else modeFamily
+    std::uint16_t primeForm = 0;
+    std::int16_t nameIndex = -1;      // Into ScaleCatalog::NAMES, -1 if the set has no common name
+    std::uint8_t cardinality = 0;
+    std::uint8_t modeIndex = 0;       // This set is mode modeIndex (0-based) of modeParent
+
+    constexpr int getStep(int degree) const { return static_cast<int>((steps >> (4 * degree)) & 0xF); }
+    constexpr int getIntervalClassCount(int intervalClass) const {
+        return static_cast<int>((intervalVector >> (4 * (intervalClass - 1))) & 0xF);
+    }
+};
+
+struct NamedScale {
+    std::string_view name;
+    std::uint16_t mask = 0;
+
+    // Steps between consecutive degrees; the step back to the octave is implied
+    static constexpr NamedScale make(std::string_view name, std::initializer_list<int> steps) {
+        std::uint16_t mask = 1;
+        int position = 0;
+        for (int step : steps) {
+            position += step;
+            mask |= static_cast<std::uint16_t>(1u << (position % 12));
+        }
+        return NamedScale{name, mask};
+    }
+};
+
+// The catalog's data, filled in a single pass over every mask during
+// constant evaluation.
+struct ScaleCatalogTable {
+    // Where two names share a mask, the first one listed is its primary name
+    static constexpr std::array<NamedScale, 52> NAMES = {{
+        NamedScale::make("Major", {2, 2, 1, 2, 2, 2}),
+        NamedScale::make("Dorian", {2, 1, 2, 2, 2, 1}),
+        NamedScale::make("Phrygian", {1, 2, 2, 2, 1, 2}),
+        NamedScale::make("Lydian", {2, 2, 2, 1, 2, 2}),
+        NamedScale::make("Mixolydian", {2, 2, 1, 2, 2, 1}),
+        NamedScale::make("Minor", {2, 1, 2, 2, 1, 2}),
+        NamedScale::make("Locrian", {1, 2, 2, 1, 2, 2}),
+        NamedScale::make("Melodic Minor", {2, 1, 2, 2, 2, 2}),
+        NamedScale::make("Dorian b2", {1, 2, 2, 2, 2, 1}),
+        NamedScale::make("Lydian Augmented", {2, 2, 2, 2, 1, 2}),
+        NamedScale::make("Lydian Dominant", {2, 2, 2, 1, 2, 1}),
+        NamedScale::make("Mixolydian b6", {2, 2, 1, 2, 1, 2}),
+        NamedScale::make("Locrian #2", {2, 1, 2, 1, 2, 2}),
+        NamedScale::make("Altered", {1, 2, 1, 2, 2, 2}),
+        NamedScale::make("Harmonic Minor", {2, 1, 2, 2, 1, 3}),
+        NamedScale::make("Locrian #6", {1, 2, 2, 1, 3, 1}),
+        NamedScale::make("Ionian #5", {2, 2, 1, 3, 1, 2}),
+        NamedScale::make("Dorian #4", {2, 1, 3, 1, 2, 1}),
+        NamedScale::make("Phrygian Dominant", {1, 3, 1, 2, 1, 2}),
+        NamedScale::make("Lydian #2", {3, 1, 2, 1, 2, 2}),
+        NamedScale::make("Ultralocrian", {1, 2, 1, 2, 2, 1}),
+        NamedScale::make("Harmonic Major", {2, 2, 1, 2, 1, 3}),
+        NamedScale::make("Double Harmonic Major", {1, 3, 1, 2, 1, 3}),
+        NamedScale::make("Hungarian Minor", {2, 1, 3, 1, 1, 3}),
+        NamedScale::make("Neapolitan Major", {1, 2, 2, 2, 2, 2}),
+        NamedScale::make("Neapolitan Minor", {1, 2, 2, 2, 1, 3}),
+        NamedScale::make("Enigmatic", {1, 3, 2, 2, 2, 1}),
+        NamedScale::make("Pentatonic Major", {2, 2, 3, 2}),
+        NamedScale::make("Suspended Pentatonic", {2, 3, 2, 3}),
+        NamedScale::make("Blues Minor Pentatonic", {3, 2, 3, 2}),
+        NamedScale::make("Blues Major Pentatonic", {2, 3, 2, 2}),
+        NamedScale::make("Pentatonic Minor", {3, 2, 2, 3}),
+        NamedScale::make("Hirajoshi", {2, 1, 4, 1}),
+        NamedScale::make("In Sen", {1, 4, 2, 3}),
+        NamedScale::make("Blues", {3, 2, 1, 1, 3}),
+        NamedScale::make("Major Blues", {2, 1, 1, 3, 2}),
+        NamedScale::make("Whole Tone", {2, 2, 2, 2, 2}),
+        NamedScale::make("Augmented", {3, 1, 3, 1, 3}),
+        NamedScale::make("Prometheus", {2, 2, 2, 3, 1}),
+        NamedScale::make("Tritone", {1, 3, 2, 1, 3}),
+        NamedScale::make("Diminished", {2, 1, 2, 1, 2, 1, 2}),
+        NamedScale::make("Dominant Diminished", {1, 2, 1, 2, 1, 2, 1}),
+        NamedScale::make("Bebop Dominant", {2, 2, 1, 2, 2, 1, 1}),
+        NamedScale::make("Bebop Major", {2, 2, 1, 2, 1, 1, 2}),
+        NamedScale{"Chromatic", 0x0FFF},
+        NamedScale::make("Ionian", {2, 2, 1, 2, 2, 2}),
+        NamedScale::make("Aeolian", {2, 1, 2, 2, 1, 2}),
+        NamedScale::make("Natural Minor", {2, 1, 2, 2, 1, 2}),
+        NamedScale::make("Super Locrian", {1, 2, 1, 2, 2, 2}),
+        NamedScale::make("Half-Diminished", {2, 1, 2, 1, 2, 2}),
+        NamedScale::make("Spanish", {1, 3, 1, 2, 1, 2}),
+        NamedScale::make("Egyptian", {2, 3, 2, 3}),
+    }};
+
+    static constexpr std::size_t HASH_SLOTS = 128;
+
+    static constexpr char lower(char c) { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c; }
+
+    static constexpr std::uint32_t hashName(std::string_view name) {
+        std::uint32_t hash = 2166136261u; // FNV-1a, case-insensitive
+        for (char c : name) {
+            hash = (hash ^ static_cast<std::uint8_t>(lower(c))) * 16777619u;
+        }
+        return hash;
+    }
+
+    static constexpr bool sameName(std::string_view a, std::string_view b) {
+        if (a.size() != b.size()) return false;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            if (lower(a[i]) != lower(b[i])) return false;
+        }
+        return true;
+    }
+
+    std::array<ScaleEntry, 4096> entries{};
+    std::array<std::int16_t, HASH_SLOTS> nameSlots{};
+
+    constexpr ScaleCatalogTable() {
+        // Single pass over every mask
+        for (std::uint16_t mask = 0; mask < 4096; ++mask) {
+            PitchClassSet set(mask);
+            ScaleEntry& entry = entries[mask];
+            entry.cardinality = static_cast<std::uint8_t>(set.size());
+            if (set.empty()) continue;
+
+            PitchClassSet rooted = set.transpose(-set.lowest());
+            int degree = 0;
+            int previous = 0;
+            rooted.forEach([&](int pc) {
+                if (pc == 0) return;
+                entry.steps |= static_cast<std::uint64_t>(pc - previous) << (4 * degree++);
+                previous = pc;
+            });
+            entry.steps |= static_cast<std::uint64_t>(12 - previous) << (4 * degree);
+
+            // ic n appears once for every member that also has a member n above it
+            for (int intervalClass = 1; intervalClass <= 6; ++intervalClass) {
+                int count = (set & set.transpose(intervalClass)).size();
+                if (intervalClass == 6) count /= 2;
+                entry.intervalVector |= static_cast<std::uint32_t>(count) << (4 * (intervalClass - 1));
+            }
+
+            // rooted is the family's normal form rotated up to one of its
+            // members; that member's rank is the mode number
+            int start = rooted.normalFormStart();
+            PitchClassSet family = rooted.transpose(-start);
+            int member = (12 - start) % 12;
+            entry.modeFamily = family.getMask();
+            entry.modeParent = family.getMask();
+            entry.modeIndex = static_cast<std::uint8_t>(std::popcount(static_cast<unsigned>(family.getMask() & ((1u << member) - 1))));
+
+            PitchClassSet inverted = family.invert().normalForm();
+            entry.primeForm = std::min(family.getMask(), inverted.getMask());
+        }
+
+        // Walk the names backwards so the first-listed name of a mask, and
+        // of a mode family, is the one that sticks
+        for (std::size_t i = NAMES.size(); i-- > 0;) {
+            PitchClassSet named(NAMES[i].mask);
+            entries[named.getMask()].nameIndex = static_cast<std::int16_t>(i);
+
+            for (int rank = named.size() - 1; rank >= 0; --rank) {
+                std::uint16_t bits = named.getMask();
+                for (int skip = 0; skip < rank; ++skip) bits &= bits - 1;
+                ScaleEntry& rotation = entries[named.transpose(-std::countr_zero(bits)).getMask()];
+                rotation.modeParent = named.getMask();
+                rotation.modeIndex = static_cast<std::uint8_t>(rank);
+            }
+        }
+
+        for (auto& slot : nameSlots) slot = -1;
+        for (std::size_t i = 0; i < NAMES.size(); ++i) {
+            std::size_t slot = hashName(NAMES[i].name) % HASH_SLOTS;
+            while (nameSlots[slot] != -1) slot = (slot + 1) % HASH_SLOTS;
+            nameSlots[slot] = static_cast<std::int16_t>(i);
+        }
+    }
+};
+
+// Every one of the 4096 pitch-class sets, indexed by mask, with names for the
+// common ones. Lookups by mask are an array index and lookups by name go
+// through a constexpr open-addressing hash table.
+class ScaleCatalog {
+    private:
+        static constexpr ScaleCatalogTable TABLE{};
+
+    public:
+        static constexpr const auto& NAMES = ScaleCatalogTable::NAMES;
+
+        static constexpr const ScaleEntry& get(PitchClassSet set) { return TABLE.entries[set.getMask()]; }
+
+        // Primary name of a set rooted on pitch class 0, or "" if it has none
+        static constexpr std::string_view nameOf(PitchClassSet set) {
+            std::int16_t index = get(set).nameIndex;
+            return index < 0 ? std::string_view{} : NAMES[index].name;
+        }
+
+        // Case-insensitive lookup of any listed name or alias
+        static constexpr std::optional<PitchClassSet> find(std::string_view name) {
+            std::size_t slot = ScaleCatalogTable::hashName(name) % ScaleCatalogTable::HASH_SLOTS;
+            while (TABLE.nameSlots[slot] != -1) {
+                const NamedScale& named = NAMES[TABLE.nameSlots[slot]];
+                if (ScaleCatalogTable::sameName(named.name, name)) return PitchClassSet(named.mask);
+                slot = (slot + 1) % ScaleCatalogTable::HASH_SLOTS;
+            }
+            return std::nullopt;
+        }
+
+        // The set rotated so that its degree-th member (0-based, ascending from
+        // the root) becomes the new root
+        static constexpr PitchClassSet mode(PitchClassSet set, int degree) {
+            int count = set.size();
+            if (count == 0) return set;
+            degree = ((degree % count) + count) % count;
+            std::uint16_t bits = set.getMask();
+            for (int i = 0; i < degree; ++i) bits &= bits - 1;
+            return set.transpose(-std::countr_zero(bits));
+        }
+};
+
+static_assert(ScaleCatalog::nameOf(ScaleCatalog::mode(*ScaleCatalog::find("major"), 1)) == "Dorian");
+static_assert(ScaleCatalog::nameOf(ScaleCatalog::mode(*ScaleCatalog::find("Melodic Minor"), 6)) == "Altered");
+static_assert(ScaleCatalog::get(*ScaleCatalog::find("Aeolian")).modeIndex == 5);
+static_assert(ScaleCatalog::get(*ScaleCatalog::find("Dorian")).modeFamily == ScaleCatalog::get(*ScaleCatalog::find("Locrian")).modeFamily);
+static_assert(ScaleCatalog::get(*ScaleCatalog::find("Major")).intervalVector == 0x163452);
+static_assert(ScaleCatalog::get(*ScaleCatalog::find("Major")).getStep(2) == 1);
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "common.hpp"
+#include "pitch_class_set.hpp"
+#include "scale_catalog.hpp"
+
+struct ScaleMatch {
+    std::int16_t nameIndex = 0;  // Into ScaleCatalog::NAMES
+    std::uint8_t root = 0;       // Pitch class the scale is built on
+    std::uint8_t extraNotes = 0; // Scale tones the query did not ask for
+
+    constexpr std::string_view getName() const { return ScaleCatalog::NAMES[nameIndex].name; }
+    constexpr PitchClassSet getPitchClassSet() const {
+        return PitchClassSet(ScaleCatalog::NAMES[nameIndex].mask).transpose(root);
+    }
+};
+
+// Reverse index answering "which named scales, on which roots, contain all of
+// these notes?". Every named scale in every key is expanded into all of its
+// subsets once, producing a ready-ranked result list per query mask, so a
+// query is two array reads.
+class ScaleFinder {
+    private:
+        std::vector<std::uint32_t> offsets; // Results for mask m are matches[offsets[m] .. offsets[m + 1])
+        std::vector<ScaleMatch> matches;
+
+        // Calls fn(nameIndex, mask) for each distinct named scale in each of the 12 keys
+        template <typename Fn>
+        static void forEachCandidate(Fn&& fn) {
+            for (std::size_t i = 0; i < ScaleCatalog::NAMES.size(); ++i) {
+                PitchClassSet shape(ScaleCatalog::NAMES[i].mask);
+                // Skip aliases, and the chromatic scale which contains everything
+                if (ScaleCatalog::get(shape).nameIndex != static_cast<std::int16_t>(i) || shape.size() == 12) continue;
+                for (int root = 0; root < 12; ++root) {
+                    fn(static_cast<std::int16_t>(i), root, shape.transpose(root).getMask());
+                }
+            }
+        }
+
+        template <typename Fn>
+        static void forEachSubset(std::uint16_t mask, Fn&& fn) {
+            for (std::uint16_t subset = mask;; subset = (subset - 1) & mask) {
+                fn(subset);
+                if (subset == 0) break;
+            }
+        }
+
+        ScaleFinder() : offsets(4097, 0) {
+            // Count, prefix-sum, then fill: one flat allocation for all lists
+            forEachCandidate([&](std::int16_t, int, std::uint16_t mask) {
+                forEachSubset(mask, [&](std::uint16_t subset) { ++offsets[subset + 1]; });
+            });
+            for (std::size_t i = 1; i < offsets.size(); ++i) {
+                offsets[i] += offsets[i - 1];
+            }
+
+            matches.resize(offsets.back());
+            std::vector<std::uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+            forEachCandidate([&](std::int16_t nameIndex, int root, std::uint16_t mask) {
+                forEachSubset(mask, [&](std::uint16_t subset) {
+                    auto extra = static_cast<std::uint8_t>(std::popcount(static_cast<unsigned>(mask & ~subset)));
+                    matches[cursor[subset]++] = ScaleMatch{nameIndex, static_cast<std::uint8_t>(root), extra};
+                });
+            });
+
+            // Tightest fit first, then scales rooted on a played note, then the
+            // more common scale (listed earlier), then by root
+            for (std::size_t mask = 0; mask < 4096; ++mask) {
+                PitchClassSet query(static_cast<std::uint16_t>(mask));
+                std::sort(matches.begin() + offsets[mask], matches.begin() + offsets[mask + 1],
+                    [query](const ScaleMatch& a, const ScaleMatch& b) {
+                        if (a.extraNotes != b.extraNotes) return a.extraNotes < b.extraNotes;
+                        bool aRooted = query.contains(a.root), bRooted = query.contains(b.root);
+                        if (aRooted != bRooted) return aRooted;
+                        if (a.nameIndex != b.nameIndex) return a.nameIndex < b.nameIndex;
+                        return a.root < b.root;
+                    });
+            }
+        }
+
+    public:
+        // Built on first use, roughly 70k matches in total
+        static const ScaleFinder& instance() {
+            static const ScaleFinder finder;
+            return finder;
+        }
+
+        // Every named scale and root containing all the given pitch classes, best first
+        std::span<const ScaleMatch> find(PitchClassSet notes) const {
+            std::uint16_t mask = notes.getMask();
+            return {matches.data() + offsets[mask], matches.data() + offsets[mask + 1]};
+        }
+};
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "common.hpp"
+#include "note.hpp"
+#include "pitch_class_set.hpp"
+#include "scale_catalog.hpp"
+
+struct ScaleFit {
+    std::int16_t nameIndex = 0;    // Into ScaleCatalog::NAMES
+    std::uint8_t root = 0;         // Pitch class the scale is built on
+    std::uint8_t missingTones = 0; // Scale tones not heard in the window
+    std::uint16_t notesInside = 0; // Window notes that belong to the scale
+    std::uint16_t notesOutside = 0;
+
+    constexpr std::string_view getName() const { return ScaleCatalog::NAMES[nameIndex].name; }
+    constexpr PitchClassSet getPitchClassSet() const {
+        return PitchClassSet(ScaleCatalog::NAMES[nameIndex].mask).transpose(root);
+    }
+};
+
+// Ranks named scales against the last windowSize notes of a melody as it
+// streams in. A note event touches only the pitch-class histogram and the
+// running counters of the candidates containing that pitch class, so the
+// cost per note does not depend on the window length.
+class ScaleFitter {
+    public:
+        // Longest window the 16-bit counters can hold
+        static constexpr std::size_t MAX_WINDOW = std::numeric_limits<std::uint16_t>::max();
+
+    private:
+        struct Candidate {
+            std::int16_t nameIndex;
+            std::uint8_t root;
+            std::uint8_t size;
+        };
+
+        // Every distinct named scale except the chromatic one, in each key,
+        // plus for each pitch class the candidates that contain it
+        struct Index {
+            std::vector<Candidate> candidates;
+            std::array<std::vector<std::uint16_t>, 12> containing;
+
+            Index() {
+                for (std::size_t i = 0; i < ScaleCatalog::NAMES.size(); ++i) {
+                    PitchClassSet shape(ScaleCatalog::NAMES[i].mask);
+                    if (ScaleCatalog::get(shape).nameIndex != static_cast<std::int16_t>(i) || shape.size() == 12) continue;
+                    for (int root = 0; root < 12; ++root) {
+                        auto id = static_cast<std::uint16_t>(candidates.size());
+                        candidates.push_back({static_cast<std::int16_t>(i), static_cast<std::uint8_t>(root), static_cast<std::uint8_t>(shape.size())});
+                        shape.transpose(root).forEach([&](int pc) { containing[pc].push_back(id); });
+                    }
+                }
+            }
+        };
+
+        static const Index& index() {
+            static const Index instance;
+            return instance;
+        }
+
+        std::vector<std::uint8_t> window; // Ring buffer of pitch classes
+        std::size_t head = 0;             // Next slot to overwrite once full
+        std::size_t filled = 0;
+        std::array<std::uint16_t, 12> histogram{};
+        std::vector<std::uint16_t> inside;  // Per candidate: window notes in the scale
+        std::vector<std::uint8_t> covered;  // Per candidate: scale tones heard at least once
+        std::vector<std::uint16_t> order;   // Ranking scratch, so bestInto() never allocates
+
+        void add(int pc) {
+            if (histogram[pc]++ == 0) {
+                for (std::uint16_t id : index().containing[pc]) ++covered[id];
+            }
+            for (std::uint16_t id : index().containing[pc]) ++inside[id];
+        }
+
+        void remove(int pc) {
+            if (--histogram[pc] == 0) {
+                for (std::uint16_t id : index().containing[pc]) --covered[id];
+            }
+            for (std::uint16_t id : index().containing[pc]) --inside[id];
+        }
+
+    public:
+        // windowSize is clamped to 1 .. MAX_WINDOW
+        explicit ScaleFitter(std::size_t windowSize = 16)
+            : window(std::clamp<std::size_t>(windowSize, 1, MAX_WINDOW)), inside(index().candidates.size()),
+              covered(index().candidates.size()), order(index().candidates.size()) {
+            for (std::size_t i = 0; i < order.size(); ++i) order[i] = static_cast<std::uint16_t>(i);
+        }
+
+        void push(int pitchClass) {
+            int pc = ((pitchClass % 12) + 12) % 12;
+            if (filled == window.size()) {
+                remove(window[head]);
+            } else {
+                ++filled;
+            }
+            window[head] = static_cast<std::uint8_t>(pc);
+            head = (head + 1) % window.size();
+            add(pc);
+        }
+
+        void push(const Note& note) { push(note.getPitchClass()); }
+
+        void reset() {
+            head = 0;
+            filled = 0;
+            histogram.fill(0);
+            std::fill(inside.begin(), inside.end(), 0);
+            std::fill(covered.begin(), covered.end(), 0);
+        }
+
+        std::size_t size() const { return filled; }
+        std::size_t capacity() const { return window.size(); }
+        const std::array<std::uint16_t, 12>& getHistogram() const { return histogram; }
+
+        // Fills out with the best-fitting scales for the current window, as
+        // many as fit: most window notes inside the scale, then fewest scale
+        // tones left unheard, then the root heard most often, then catalog
+        // order. Returns how many were written; nothing is allocated. Not
+        // const, since ranking reorders the fitter's own scratch.
+        std::size_t bestInto(std::span<ScaleFit> out) {
+            const auto& candidates = index().candidates;
+            auto better = [&](std::uint16_t a, std::uint16_t b) {
+                if (inside[a] != inside[b]) return inside[a] > inside[b];
+                int missingA = candidates[a].size - covered[a], missingB = candidates[b].size - covered[b];
+                if (missingA != missingB) return missingA < missingB;
+                if (histogram[candidates[a].root] != histogram[candidates[b].root]) {
+                    return histogram[candidates[a].root] > histogram[candidates[b].root];
+                }
+                return a < b;
+            };
+
+            // order always holds every candidate once, so it is re-ranked in place
+            std::size_t count = std::min(out.size(), order.size());
+            std::partial_sort(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(count), order.end(), better);
+
+            for (std::size_t i = 0; i < count; ++i) {
+                std::uint16_t id = order[i];
+                out[i] = {candidates[id].nameIndex, candidates[id].root,
+                          static_cast<std::uint8_t>(candidates[id].size - covered[id]), inside[id],
+                          static_cast<std::uint16_t>(filled - inside[id])};
+            }
+            return count;
+        }
+
+        // The count best-fitting scales, ranked as by bestInto
+        std::vector<ScaleFit> best(std::size_t count) {
+            std::vector<ScaleFit> fits(std::min(count, order.size()));
+            fits.resize(bestInto(fits));
+            return fits;
+        }
+};
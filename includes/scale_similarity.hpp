@@ -0,0 +1,323 @@
+#pragma once
+
+#include "common.hpp"
+#include "pitch_class_set.hpp"
+#include "scale_catalog.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// How close two rooted scales are. All three measures are in the 0..12 range
+// except voiceLeading, which is a sum of semitone moves and tops out well below 255.
+struct ScaleSimilarity {
+    std::uint8_t hamming = 0;      // Pitch classes in exactly one of the two scales
+    std::uint8_t commonTones = 0;  // Pitch classes in both scales
+    std::uint8_t voiceLeading = 0; // Smallest total semitone motion from one scale to the other
+    std::uint8_t reserved = 0;
+};
+
+static_assert(sizeof(ScaleSimilarity) == 4);
+
+// The scales the matrix covers: every distinct named catalog shape, in
+// catalog order (aliases dropped), on each of the 12 roots
+struct SimilarityUniverse {
+    std::array<std::uint16_t, ScaleCatalog::NAMES.size()> shapes{};
+    std::array<std::int16_t, ScaleCatalog::NAMES.size()> nameIndices{};
+    std::size_t count = 0;
+
+    constexpr SimilarityUniverse() {
+        for (std::size_t i = 0; i < ScaleCatalog::NAMES.size(); ++i) {
+            PitchClassSet shape(ScaleCatalog::NAMES[i].mask);
+            if (ScaleCatalog::get(shape).nameIndex != static_cast<std::int16_t>(i)) continue; // Alias
+            shapes[count] = shape.getMask();
+            nameIndices[count] = static_cast<std::int16_t>(i);
+            ++count;
+        }
+    }
+};
+
+// Pairwise similarity of every rooted scale in SimilarityUniverse. Rows are
+// computed in parallel and can be saved to a flat binary file that later runs
+// memory-map instead of recomputing. Index i is (shape slot * 12 + root).
+class SimilarityMatrix {
+    private:
+        struct Header {
+            char magic[4];
+            std::uint32_t version;
+            std::uint32_t shapeCount;
+            std::uint32_t reserved;
+        };
+
+        static constexpr char MAGIC[4] = {'S', 'S', 'I', 'M'};
+        static constexpr std::uint32_t VERSION = 1;
+
+        std::vector<ScaleSimilarity> owned;
+        void* mapped = nullptr;
+        std::size_t mappedSize = 0;
+        const ScaleSimilarity* cells = nullptr;
+
+        static constexpr std::size_t cellOffset() {
+            return sizeof(Header) + UNIVERSE.count * sizeof(std::uint16_t);
+        }
+
+        // Semitones from pc to the nearest member of mask (mask must not be empty)
+        static int nearestDistance(int pc, PitchClassSet mask) {
+            unsigned rotated = mask.transpose(-pc).getMask();
+            if (rotated & 1u) return 0;
+            int up = std::countr_zero(rotated);
+            int down = 12 - (std::bit_width(rotated) - 1);
+            return std::min(up, down);
+        }
+
+        static int circularDistance(int a, int b) {
+            int d = a > b ? a - b : b - a;
+            return std::min(d, 12 - d);
+        }
+
+        // Same-size scales: the best order-preserving pairing is one of the n
+        // cyclic alignments of the sorted pitch classes. Otherwise every note
+        // of each scale moves to its nearest neighbour in the other, and the
+        // larger of the two directions is the cost.
+        static int voiceLeadingDistance(PitchClassSet a, PitchClassSet b) {
+            std::array<std::int8_t, 12> from{}, to{};
+            int fromSize = 0, toSize = 0;
+            a.forEach([&](int pc) { from[fromSize++] = static_cast<std::int8_t>(pc); });
+            b.forEach([&](int pc) { to[toSize++] = static_cast<std::int8_t>(pc); });
+
+            if (fromSize == toSize) {
+                int best = std::numeric_limits<int>::max();
+                for (int shift = 0; shift < fromSize; ++shift) {
+                    int total = 0;
+                    for (int i = 0; i < fromSize && total < best; ++i) {
+                        total += circularDistance(from[i], to[(i + shift) % toSize]);
+                    }
+                    best = std::min(best, total);
+                }
+                return best;
+            }
+
+            int forward = 0, backward = 0;
+            for (int i = 0; i < fromSize; ++i) forward += nearestDistance(from[i], b);
+            for (int i = 0; i < toSize; ++i) backward += nearestDistance(to[i], a);
+            return std::max(forward, backward);
+        }
+
+        static ScaleSimilarity compare(PitchClassSet a, PitchClassSet b) {
+            ScaleSimilarity result;
+            result.hamming = static_cast<std::uint8_t>((a ^ b).size());
+            result.commonTones = static_cast<std::uint8_t>((a & b).size());
+            result.voiceLeading = static_cast<std::uint8_t>(voiceLeadingDistance(a, b));
+            return result;
+        }
+
+        void release() {
+            if (mapped) munmap(mapped, mappedSize);
+            mapped = nullptr;
+            mappedSize = 0;
+            cells = nullptr;
+        }
+
+        SimilarityMatrix() = default;
+
+    public:
+        static constexpr SimilarityUniverse UNIVERSE{};
+        static constexpr std::size_t SIZE = UNIVERSE.count * 12;
+
+        SimilarityMatrix(const SimilarityMatrix&) = delete;
+        SimilarityMatrix& operator=(const SimilarityMatrix&) = delete;
+
+        SimilarityMatrix(SimilarityMatrix&& other) noexcept
+            : owned(std::move(other.owned)), mapped(other.mapped), mappedSize(other.mappedSize), cells(other.cells) {
+            other.mapped = nullptr;
+            other.mappedSize = 0;
+            other.cells = nullptr;
+        }
+
+        SimilarityMatrix& operator=(SimilarityMatrix&& other) noexcept {
+            if (this != &other) {
+                release();
+                owned = std::move(other.owned);
+                mapped = other.mapped;
+                mappedSize = other.mappedSize;
+                cells = other.cells;
+                other.mapped = nullptr;
+                other.mappedSize = 0;
+                other.cells = nullptr;
+            }
+            return *this;
+        }
+
+        ~SimilarityMatrix() { release(); }
+
+        static PitchClassSet getShape(std::size_t index) { return PitchClassSet(UNIVERSE.shapes[index / 12]); }
+        static int getRoot(std::size_t index) { return static_cast<int>(index % 12); }
+        static PitchClassSet getPitchClassSet(std::size_t index) { return getShape(index).transpose(getRoot(index)); }
+        static std::string_view getName(std::size_t index) { return ScaleCatalog::NAMES[UNIVERSE.nameIndices[index / 12]].name; }
+
+        // Index of a named shape on a root, or nullopt if the shape has no catalog name
+        static std::optional<std::size_t> indexOf(PitchClassSet shape, int root) {
+            std::int16_t nameIndex = ScaleCatalog::get(shape).nameIndex;
+            for (std::size_t slot = 0; slot < UNIVERSE.count; ++slot) {
+                if (UNIVERSE.nameIndices[slot] == nameIndex && nameIndex >= 0) {
+                    return slot * 12 + static_cast<std::size_t>(((root % 12) + 12) % 12);
+                }
+            }
+            return std::nullopt;
+        }
+
+        // Builds the full matrix, handing out rows to threadCount workers
+        static SimilarityMatrix compute(unsigned threadCount = std::thread::hardware_concurrency()) {
+            std::array<PitchClassSet, SIZE> sets;
+            for (std::size_t i = 0; i < SIZE; ++i) sets[i] = getPitchClassSet(i);
+
+            SimilarityMatrix matrix;
+            matrix.owned.resize(SIZE * SIZE);
+            ScaleSimilarity* out = matrix.owned.data();
+
+            std::atomic<std::size_t> nextRow{0};
+            auto worker = [&]() {
+                for (std::size_t row = nextRow++; row < SIZE; row = nextRow++) {
+                    for (std::size_t column = 0; column < SIZE; ++column) {
+                        out[row * SIZE + column] = compare(sets[row], sets[column]);
+                    }
+                }
+            };
+
+            std::vector<std::thread> workers;
+            for (unsigned t = 1; t < std::max(threadCount, 1u); ++t) workers.emplace_back(worker);
+            worker();
+            for (std::thread& thread : workers) thread.join();
+
+            matrix.cells = out;
+            return matrix;
+        }
+
+        // Maps a file written by save(); nullopt if it is missing, truncated or
+        // was built from a different catalog
+        static std::optional<SimilarityMatrix> load(const std::string& path) {
+            int fd = open(path.c_str(), O_RDONLY);
+            if (fd < 0) return std::nullopt;
+
+            struct stat info;
+            std::size_t expectedSize = cellOffset() + SIZE * SIZE * sizeof(ScaleSimilarity);
+            if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) != expectedSize) {
+                close(fd);
+                return std::nullopt;
+            }
+
+            void* region = mmap(nullptr, expectedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+            close(fd);
+            if (region == MAP_FAILED) return std::nullopt;
+
+            SimilarityMatrix matrix;
+            matrix.mapped = region;
+            matrix.mappedSize = expectedSize;
+
+            const auto* bytes = static_cast<const unsigned char*>(region);
+            Header header;
+            std::memcpy(&header, bytes, sizeof(Header));
+            if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION || header.shapeCount != UNIVERSE.count ||
+                std::memcmp(bytes + sizeof(Header), UNIVERSE.shapes.data(), UNIVERSE.count * sizeof(std::uint16_t)) != 0) {
+                return std::nullopt;
+            }
+
+            matrix.cells = reinterpret_cast<const ScaleSimilarity*>(bytes + cellOffset());
+            return matrix;
+        }
+
+        // Writes a private temporary file and renames it over path, so a
+        // process that has the old file mapped keeps its copy and a crash
+        // never leaves a torn cache behind
+        bool save(const std::string& path) const {
+            std::string temporary = path + ".tmp" + std::to_string(getpid());
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            if (!file) return false;
+
+            Header header{};
+            std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+            header.version = VERSION;
+            header.shapeCount = static_cast<std::uint32_t>(UNIVERSE.count);
+
+            file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+            file.write(reinterpret_cast<const char*>(UNIVERSE.shapes.data()), UNIVERSE.count * sizeof(std::uint16_t));
+            file.write(reinterpret_cast<const char*>(cells), SIZE * SIZE * sizeof(ScaleSimilarity));
+            file.close();
+            bool written = !file.fail();
+
+            std::error_code error;
+            if (written) std::filesystem::rename(temporary, path, error);
+            if (!written || error) {
+                std::filesystem::remove(temporary, error);
+                return false;
+            }
+            return true;
+        }
+
+        // Where the cache lives by default: under $XDG_CACHE_HOME, else
+        // ~/.cache, else next to the executable, so it is found again from
+        // any working directory
+        static std::string defaultCachePath() {
+            namespace fs = std::filesystem;
+            constexpr std::string_view DIRECTORY = "guitar-theory-companion";
+            constexpr std::string_view FILE_NAME = "scale_similarity.bin";
+            const char* xdg = std::getenv("XDG_CACHE_HOME");
+            const char* home = std::getenv("HOME");
+            if (xdg && xdg[0] == '/') return (fs::path(xdg) / DIRECTORY / FILE_NAME).string();
+            if (home && home[0] == '/') return (fs::path(home) / ".cache" / DIRECTORY / FILE_NAME).string();
+
+            std::error_code error;
+            fs::path executable = fs::read_symlink("/proc/self/exe", error);
+            return ((error ? fs::temp_directory_path(error) : executable.parent_path()) / FILE_NAME).string();
+        }
+
+        // Loads path if it holds a current matrix; otherwise computes one and
+        // writes it there for next time, warning if that fails
+        static SimilarityMatrix loadOrCompute(const std::string& path) {
+            if (auto matrix = load(path)) return std::move(*matrix);
+            SimilarityMatrix matrix = compute();
+
+            std::error_code error;
+            std::filesystem::path parent = std::filesystem::path(path).parent_path();
+            if (!parent.empty()) std::filesystem::create_directories(parent, error);
+            if (!matrix.save(path)) {
+                std::cerr << "Warning: could not write the scale similarity cache to " << path
+                          << "; it will be computed again next time." << std::endl;
+            }
+            return matrix;
+        }
+
+        bool isMapped() const { return mapped != nullptr; }
+
+        const ScaleSimilarity& at(std::size_t from, std::size_t to) const { return cells[from * SIZE + to]; }
+
+        // The count closest scales to index: least voice-leading motion first,
+        // then fewest differing notes, then catalog order. Scales with exactly the
+        // same notes (the scale itself and its modes) are skipped.
+        std::vector<std::size_t> related(std::size_t index, std::size_t count) const {
+            std::vector<std::size_t> candidates;
+            candidates.reserve(SIZE - 1);
+            for (std::size_t other = 0; other < SIZE; ++other) {
+                if (at(index, other).hamming != 0) candidates.push_back(other);
+            }
+
+            auto closer = [&](std::size_t a, std::size_t b) {
+                const ScaleSimilarity& x = at(index, a);
+                const ScaleSimilarity& y = at(index, b);
+                if (x.voiceLeading != y.voiceLeading) return x.voiceLeading < y.voiceLeading;
+                if (x.hamming != y.hamming) return x.hamming < y.hamming;
+                return a < b;
+            };
+
+            count = std::min(count, candidates.size());
+            std::partial_sort(candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(count), candidates.end(), closer);
+            candidates.resize(count);
+            return candidates;
+        }
+};
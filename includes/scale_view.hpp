@@ -0,0 +1,101 @@
+#pragma once
+
+#include "common.hpp"
+#include "note.hpp"
+#include "pitch_class_set.hpp"
+#include <iterator>
+#include <ranges>
+
+enum class Direction : std::uint8_t {
+    Ascending,
+    Descending
+};
+
+// A lazy range over every note of a pitch-class set between two MIDI values
+// (inclusive), walked upwards or downwards. Nothing is materialized: each
+// step finds the next member with one rotate and one bit scan, so the view
+// composes with std::views adaptors at no allocation cost.
+class ScaleView : public std::ranges::view_interface<ScaleView> {
+    private:
+        PitchClassSet set;
+        int low = 0;
+        int high = -1;
+        Direction direction = Direction::Ascending;
+
+        static constexpr int pitchClassOf(int midi) { return ((midi % 12) + 12) % 12; }
+
+    public:
+        // Distance to the nearest member strictly above midi, or 0 if the set is empty
+        static constexpr int stepUp(PitchClassSet set, int midi) {
+            std::uint16_t rotated = set.transpose(-(pitchClassOf(midi) + 1)).getMask();
+            return rotated == 0 ? 0 : std::countr_zero(rotated) + 1;
+        }
+
+        // Distance to the nearest member strictly below midi, or 0 if the set is empty
+        static constexpr int stepDown(PitchClassSet set, int midi) {
+            // Rotate so that midi - 1 lands on bit 11; the highest set bit is then the closest member
+            std::uint16_t rotated = set.transpose(12 - pitchClassOf(midi)).getMask();
+            return rotated == 0 ? 0 : 13 - std::bit_width(rotated);
+        }
+
+        class Iterator {
+            private:
+                PitchClassSet set;
+                int current = 0;
+                int bound = -1;
+                Direction direction = Direction::Ascending;
+
+            public:
+                using value_type = Note;
+                using difference_type = std::ptrdiff_t;
+                using iterator_concept = std::forward_iterator_tag;
+
+                constexpr Iterator() = default;
+                constexpr Iterator(PitchClassSet pitchClasses, int start, int end, Direction walk)
+                    : set(pitchClasses), current(start), bound(end), direction(walk) {}
+
+                constexpr Note operator*() const { return Note(current); }
+
+                constexpr Iterator& operator++() {
+                    if (direction == Direction::Ascending) {
+                        int step = stepUp(set, current);
+                        current = step == 0 ? bound + 1 : current + step;
+                    } else {
+                        int step = stepDown(set, current);
+                        current = step == 0 ? bound - 1 : current - step;
+                    }
+                    return *this;
+                }
+
+                constexpr Iterator operator++(int) {
+                    Iterator previous = *this;
+                    ++*this;
+                    return previous;
+                }
+
+                constexpr bool operator==(const Iterator& other) const { return current == other.current; }
+
+                constexpr bool operator==(std::default_sentinel_t) const {
+                    return direction == Direction::Ascending ? current > bound : current < bound;
+                }
+        };
+
+        constexpr ScaleView() = default;
+        constexpr ScaleView(PitchClassSet pitchClasses, int lowMidi, int highMidi, Direction walk = Direction::Ascending)
+            : set(pitchClasses), low(lowMidi), high(highMidi), direction(walk) {}
+
+        constexpr Iterator begin() const {
+            if (set.empty()) return Iterator(set, high + 1, high, Direction::Ascending);
+            if (direction == Direction::Ascending) {
+                int start = set.contains(pitchClassOf(low)) ? low : low + stepUp(set, low);
+                return Iterator(set, start, high, direction);
+            }
+            int start = set.contains(pitchClassOf(high)) ? high : high - stepDown(set, high);
+            return Iterator(set, start, low, direction);
+        }
+
+        constexpr std::default_sentinel_t end() const { return std::default_sentinel; }
+};
+
+static_assert(std::ranges::forward_range<ScaleView>);
+static_assert(std::ranges::view<ScaleView>);
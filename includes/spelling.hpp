@@ -0,0 +1,149 @@
+#pragma once
+
+#include "common.hpp"
+#include "catalog.hpp"
+
+// A pitch class spelled as a letter plus accidental, e.g. Bb rather than A#.
+struct SpelledPitch {
+    std::uint8_t letter = 0;    // 0 = C, 1 = D, ... 6 = B
+    std::int8_t accidental = 0; // -2 = double flat ... +2 = double sharp
+
+    static constexpr std::array<int, 7> NATURAL_PITCH_CLASSES = {0, 2, 4, 5, 7, 9, 11};
+    static constexpr std::array<std::array<std::string_view, 5>, 7> NAMES = {{
+        {"Cbb", "Cb", "C", "C#", "C##"},
+        {"Dbb", "Db", "D", "D#", "D##"},
+        {"Ebb", "Eb", "E", "E#", "E##"},
+        {"Fbb", "Fb", "F", "F#", "F##"},
+        {"Gbb", "Gb", "G", "G#", "G##"},
+        {"Abb", "Ab", "A", "A#", "A##"},
+        {"Bbb", "Bb", "B", "B#", "B##"},
+    }};
+
+    constexpr int getPitchClass() const {
+        return ((NATURAL_PITCH_CLASSES[letter] + accidental) % 12 + 12) % 12;
+    }
+
+    constexpr std::string_view getName() const { return NAMES[letter][accidental + 2]; }
+
+    // Position on the line of fifths, C = 0, G = 1, F = -1, Bb = -2, ...
+    static constexpr SpelledPitch fromFifths(int fifths) {
+        constexpr std::array<std::uint8_t, 7> LETTERS = {3, 0, 4, 1, 5, 2, 6}; // F C G D A E B
+        int shifted = fifths + 1;
+        int index = ((shifted % 7) + 7) % 7;
+        int accidental = (shifted - index) / 7;
+        return SpelledPitch{LETTERS[index], static_cast<std::int8_t>(accidental)};
+    }
+
+    // Spells a pitch class on the given letter, or returns nullopt if that
+    // would need more than a double accidental
+    static constexpr std::optional<SpelledPitch> onLetter(int letter, int pitchClass) {
+        letter = ((letter % 7) + 7) % 7;
+        int accidental = ((pitchClass - NATURAL_PITCH_CLASSES[letter]) % 12 + 12) % 12;
+        if (accidental > 6) accidental -= 12;
+        if (accidental < -2 || accidental > 2) return std::nullopt;
+        return SpelledPitch{static_cast<std::uint8_t>(letter), static_cast<std::int8_t>(accidental)};
+    }
+
+    constexpr bool operator==(const SpelledPitch&) const = default;
+};
+
+// A tonic pitch class together with the scale that defines its tonality.
+struct Key {
+    ScaleType type = ScaleType::Major;
+    std::uint8_t tonic = 0;
+
+    // Keys whose scale has a minor but no major third take minor key signatures
+    constexpr bool isMinor() const {
+        std::uint16_t mask = FormulaCatalog::get(type).mask;
+        return (mask & (1u << 3)) && !(mask & (1u << 4));
+    }
+
+    constexpr bool operator==(const Key&) const = default;
+};
+
+// Spellings for every (scale, tonic, pitch class) triple, resolved once
+// during constant evaluation.
+struct KeySpellingTable {
+    static constexpr std::size_t SCALE_COUNT = static_cast<std::size_t>(ScaleType::Count);
+
+    std::array<std::array<std::array<SpelledPitch, 12>, 12>, SCALE_COUNT> entries{};
+
+    // First slot of the 12-wide window on the line of fifths that a key
+    // draws its tonic from. Majors run Db..F#, minors Eb..G#.
+    static constexpr int tonicWindowStart(bool minor) { return minor ? -3 : -5; }
+
+    static constexpr int pickFifths(int windowStart, int pitchClass) {
+        // Multiplying by 7 maps a pitch class to its line-of-fifths residue
+        return windowStart + ((7 * pitchClass - windowStart) % 12 + 12) % 12;
+    }
+
+    constexpr KeySpellingTable() {
+        for (std::size_t type = 0; type < SCALE_COUNT; ++type) {
+            const ScaleFormula& formula = FormulaCatalog::SCALES[type];
+            for (int tonic = 0; tonic < 12; ++tonic) {
+                Key key{static_cast<ScaleType>(type), static_cast<std::uint8_t>(tonic)};
+                bool minor = key.isMinor();
+                int tonicFifths = pickFifths(tonicWindowStart(minor), tonic);
+                SpelledPitch tonicSpelling = SpelledPitch::fromFifths(tonicFifths);
+
+                // Chromatic tones come from the window centred on the key signature
+                int chromaticStart = tonicFifths - (minor ? 6 : 4);
+                for (int pc = 0; pc < 12; ++pc) {
+                    entries[type][tonic][pc] = SpelledPitch::fromFifths(pickFifths(chromaticStart, pc));
+                }
+
+                // Seven-note scales use each letter exactly once
+                if (formula.steps.size() == 7) {
+                    int position = tonic;
+                    for (int degree = 0; degree < 7; ++degree) {
+                        auto spelled = SpelledPitch::onLetter(tonicSpelling.letter + degree, position % 12);
+                        if (spelled) {
+                            entries[type][tonic][position % 12] = *spelled;
+                        }
+                        position += formula.steps[degree];
+                    }
+                }
+            }
+        }
+    }
+};
+
+// Key-aware spelling. Lookups go straight to the constexpr table, so
+// spelling on the hot path costs one indexed load.
+class Speller {
+    private:
+        static constexpr KeySpellingTable TABLE{};
+
+        // Letter steps above a chord root for each offset in semitones (two octaves)
+        static constexpr std::array<std::uint8_t, 24> CHORD_TONE_LETTERS = {
+            0, 1, 1, 2, 2, 3, 4, 4, 4, 5, 6, 6,
+            0, 1, 1, 1, 2, 3, 3, 4, 5, 5, 6, 6
+        };
+
+    public:
+        static constexpr SpelledPitch spell(const Key& key, int pitchClass) {
+            return TABLE.entries[static_cast<std::size_t>(key.type)][key.tonic % 12][((pitchClass % 12) + 12) % 12];
+        }
+
+        static constexpr SpelledPitch tonic(const Key& key) { return spell(key, key.tonic); }
+
+        // Spells a chord tone by stacking letters on the chord root, so that
+        // e.g. Bb7 gets D, F, Ab. chordMask tells a diminished 7th (bb7) from a 6th.
+        static constexpr SpelledPitch spellChordTone(SpelledPitch root, int offset, std::uint16_t chordMask) {
+            int pitchClass = root.getPitchClass() + offset;
+            int letterStep = CHORD_TONE_LETTERS[offset % 24];
+            bool diminishedSeventh = offset == 9 && (chordMask & (1u << 6)) && !(chordMask & 0b110010000000);
+            if (diminishedSeventh) letterStep = 6;
+
+            auto spelled = SpelledPitch::onLetter(root.letter + letterStep, pitchClass % 12);
+            if (spelled) return *spelled;
+            return spell(Key{ScaleType::Major, static_cast<std::uint8_t>(root.getPitchClass())}, pitchClass);
+        }
+};
+
+static_assert(Speller::spell(Key{ScaleType::Major, 5}, 10).getName() == "Bb");
+static_assert(Speller::spell(Key{ScaleType::Major, 7}, 6).getName() == "F#");
+static_assert(Speller::spell(Key{ScaleType::HarmonicMinor, 9}, 8).getName() == "G#");
+static_assert(Speller::spell(Key{ScaleType::HarmonicMinor, 8}, 7).getName() == "F##");
+static_assert(Speller::tonic(Key{ScaleType::Minor, 3}).getName() == "Eb");
+static_assert(Speller::spellChordTone(SpelledPitch{0, 0}, 9, 0b001001001001).getName() == "Bbb");
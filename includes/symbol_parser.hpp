@@ -0,0 +1,158 @@
+#pragma once
+
+#include "common.hpp"
+#include "catalog.hpp"
+#include "spelling.hpp"
+
+struct ParsedNote {
+    SpelledPitch pitch;
+    std::size_t length = 0; // Characters consumed from the input
+};
+
+struct ParsedChord {
+    SpelledPitch root;
+    ChordType type = ChordType::Major;
+    std::optional<SpelledPitch> bass; // Set for slash chords such as C/G
+};
+
+// Parses note names and chord symbols straight out of a string_view.
+// Nothing here allocates; malformed input yields std::nullopt.
+class SymbolParser {
+    private:
+        struct QualityAlias {
+            std::string_view symbol;
+            ChordType type;
+        };
+
+        // Spellings accepted on top of the catalog's own symbols
+        static constexpr std::array<QualityAlias, 34> QUALITY_ALIASES = {{
+            {"M", ChordType::Major},
+            {"maj", ChordType::Major},
+            {"min", ChordType::Minor},
+            {"-", ChordType::Minor},
+            {"dom7", ChordType::Dominant7},
+            {"M7", ChordType::Major7},
+            {"Maj7", ChordType::Major7},
+            {"min7", ChordType::Minor7},
+            {"-7", ChordType::Minor7},
+            {"o", ChordType::Diminished},
+            {"°", ChordType::Diminished},
+            {"+", ChordType::Augmented},
+            {"ø", ChordType::HalfDiminished7},
+            {"ø7", ChordType::HalfDiminished7},
+            {"min7b5", ChordType::HalfDiminished7},
+            {"o7", ChordType::Diminished7},
+            {"°7", ChordType::Diminished7},
+            {"sus", ChordType::Sus4},
+            {"7sus", ChordType::Dominant7Sus4},
+            {"add2", ChordType::Add9},
+            {"min6", ChordType::Minor6},
+            {"-6", ChordType::Minor6},
+            {"69", ChordType::SixNine},
+            {"mM7", ChordType::MinorMajor7},
+            {"m(maj7)", ChordType::MinorMajor7},
+            {"M9", ChordType::Major9},
+            {"min9", ChordType::Minor9},
+            {"-9", ChordType::Minor9},
+            {"min11", ChordType::Minor11},
+            {"aug7", ChordType::Dominant7Sharp5},
+            {"7+5", ChordType::Dominant7Sharp5},
+            {"alt", ChordType::Altered},
+            {"+maj7", ChordType::AugmentedMajor7},
+            {"augMaj7", ChordType::AugmentedMajor7},
+        }};
+
+        static constexpr int letterIndex(char c) {
+            switch (c) {
+                case 'C': case 'c': return 0;
+                case 'D': case 'd': return 1;
+                case 'E': case 'e': return 2;
+                case 'F': case 'f': return 3;
+                case 'G': case 'g': return 4;
+                case 'A': case 'a': return 5;
+                case 'B': case 'b': return 6;
+                default: return -1;
+            }
+        }
+
+    public:
+        // Reads a note name from the front of text: a letter in either case
+        // followed by up to two accidentals (#, b, x for double sharp).
+        static constexpr std::optional<ParsedNote> parseNotePrefix(std::string_view text) {
+            if (text.empty()) return std::nullopt;
+            int letter = letterIndex(text[0]);
+            if (letter < 0) return std::nullopt;
+
+            std::size_t position = 1;
+            int accidental = 0;
+            if (position < text.size() && text[position] == 'x') {
+                accidental = 2;
+                ++position;
+            } else {
+                while (position < text.size() && position <= 2) {
+                    if (text[position] == '#' && accidental >= 0) {
+                        ++accidental;
+                    } else if (text[position] == 'b' && accidental <= 0) {
+                        --accidental;
+                    } else {
+                        break;
+                    }
+                    ++position;
+                }
+            }
+
+            SpelledPitch pitch{static_cast<std::uint8_t>(letter), static_cast<std::int8_t>(accidental)};
+            return ParsedNote{pitch, position};
+        }
+
+        // Parses text that must consist of exactly one note name
+        static constexpr std::optional<SpelledPitch> parseNote(std::string_view text) {
+            auto parsed = parseNotePrefix(text);
+            if (!parsed || parsed->length != text.size()) return std::nullopt;
+            return parsed->pitch;
+        }
+
+        static constexpr std::optional<ChordType> parseQuality(std::string_view suffix) {
+            if (auto type = FormulaCatalog::findChord(suffix)) return type;
+            for (const auto& alias : QUALITY_ALIASES) {
+                if (alias.symbol == suffix) return alias.type;
+            }
+            return std::nullopt;
+        }
+
+        // Parses a full chord symbol: root, quality suffix and optional /bass
+        static constexpr std::optional<ParsedChord> parseChord(std::string_view text) {
+            auto root = parseNotePrefix(text);
+            if (!root) return std::nullopt;
+            text.remove_prefix(root->length);
+
+            ParsedChord chord{root->pitch, ChordType::Major, std::nullopt};
+            // A slash is a bass note only if a note follows it; "6/9" is a quality
+            std::size_t slash = text.rfind('/');
+            if (slash != std::string_view::npos) {
+                if (auto bass = parseNote(text.substr(slash + 1))) {
+                    chord.bass = *bass;
+                    text = text.substr(0, slash);
+                }
+            }
+
+            auto quality = parseQuality(text);
+            if (!quality) return std::nullopt;
+            chord.type = *quality;
+            return chord;
+        }
+};
+
+static_assert(SymbolParser::parseNote("b")->getName() == "B");
+static_assert(SymbolParser::parseNote("Bb")->getName() == "Bb");
+static_assert(SymbolParser::parseNote("bb")->getName() == "Bb");
+static_assert(SymbolParser::parseNote("Fx")->getName() == "F##");
+static_assert(SymbolParser::parseNote("Ebb")->getName() == "Ebb");
+static_assert(!SymbolParser::parseNote("H"));
+static_assert(!SymbolParser::parseNote("C#b"));
+static_assert(SymbolParser::parseChord("C#m7b5/G")->type == ChordType::HalfDiminished7);
+static_assert(SymbolParser::parseChord("C#m7b5/G")->bass->getName() == "G");
+static_assert(SymbolParser::parseChord("Bbmaj7")->root.getName() == "Bb");
+static_assert(!SymbolParser::parseChord("Cfoo"));
+static_assert(SymbolParser::parseChord("C6/9")->type == ChordType::SixNine && !SymbolParser::parseChord("C6/9")->bass);
+static_assert(SymbolParser::parseChord("G7#9/B")->type == ChordType::Dominant7Sharp9);
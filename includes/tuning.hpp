@@ -0,0 +1,216 @@
+#pragma once
+
+#include "common.hpp"
+#include "catalog.hpp"
+#include <cmath>
+#include <charconv>
+
+// A tuning: a list of step sizes repeating every period (usually an octave),
+// anchored so that step 0 sounds at a reference frequency. Cents, frequency
+// and 12-EDO-to-step tables are built once on construction, so every lookup
+// afterwards is O(1). The 12-EDO Note/Scale/Chord types never go through
+// here, so their fast path is unaffected.
+class Tuning {
+    private:
+        std::string name;
+        std::vector<double> stepCents;  // Cents above step 0 for each step in one period
+        double periodCents = 1200.0;
+        double referenceHz = 261.6255653005986; // Step 0, middle C at A4 = 440
+        std::vector<double> frequencies;          // Steps -TABLE_PERIODS * n .. TABLE_PERIODS * n - 1
+        std::array<int, 12> semitoneSteps{};      // Nearest step to each 12-EDO semitone
+
+        static constexpr int TABLE_PERIODS = 5;
+
+        Tuning(std::string tuningName, std::vector<double> cents, double period, double rootHz)
+            : name(std::move(tuningName)), stepCents(std::move(cents)), periodCents(period), referenceHz(rootHz) {
+            buildTables();
+        }
+
+        void buildTables() {
+            int n = getStepsPerPeriod();
+            frequencies.resize(2 * TABLE_PERIODS * n);
+            for (int i = 0; i < static_cast<int>(frequencies.size()); ++i) {
+                frequencies[i] = computeFrequency(i - TABLE_PERIODS * n);
+            }
+            for (int semitone = 0; semitone < 12; ++semitone) {
+                semitoneSteps[semitone] = nearestStep(semitone * 100.0);
+            }
+        }
+
+        double computeFrequency(int step) const {
+            return referenceHz * std::exp2(getCents(step) / 1200.0);
+        }
+
+        // Parses one Scala pitch line: cents if it contains a '.', else a ratio or integer
+        static std::optional<double> parseScalaPitch(std::string_view line) {
+            std::size_t start = line.find_first_not_of(" \t");
+            if (start == std::string_view::npos) return std::nullopt;
+            line.remove_prefix(start);
+            line = line.substr(0, line.find_first_of(" \t\r"));
+
+            if (line.find('.') != std::string_view::npos) {
+                double cents = 0.0;
+                auto [end, error] = std::from_chars(line.data(), line.data() + line.size(), cents);
+                if (error != std::errc() || end != line.data() + line.size()) return std::nullopt;
+                return cents;
+            }
+
+            long long numerator = 0, denominator = 1;
+            std::size_t slash = line.find('/');
+            std::string_view top = line.substr(0, slash);
+            auto [topEnd, topError] = std::from_chars(top.data(), top.data() + top.size(), numerator);
+            if (topError != std::errc() || topEnd != top.data() + top.size()) return std::nullopt;
+            if (slash != std::string_view::npos) {
+                std::string_view bottom = line.substr(slash + 1);
+                auto [bottomEnd, bottomError] = std::from_chars(bottom.data(), bottom.data() + bottom.size(), denominator);
+                if (bottomError != std::errc() || bottomEnd != bottom.data() + bottom.size()) return std::nullopt;
+            }
+            if (numerator <= 0 || denominator <= 0) return std::nullopt;
+            return 1200.0 * std::log2(static_cast<double>(numerator) / static_cast<double>(denominator));
+        }
+
+    public:
+        // n equal divisions of the octave, e.g. 12, 19, 24 or 31
+        static Tuning equalDivision(int divisions, double rootHz = 261.6255653005986) {
+            divisions = std::max(divisions, 1);
+            std::vector<double> cents(divisions);
+            for (int step = 0; step < divisions; ++step) {
+                cents[step] = 1200.0 * step / divisions;
+            }
+            return Tuning(std::to_string(divisions) + "-EDO", std::move(cents), 1200.0, rootHz);
+        }
+
+        // Parses the text of a Scala .scl file; returns nullopt if it is malformed
+        static std::optional<Tuning> fromScala(std::string_view text, double rootHz = 261.6255653005986) {
+            std::vector<std::string_view> lines;
+            while (!text.empty()) {
+                std::size_t end = text.find('\n');
+                std::string_view line = text.substr(0, end);
+                if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+                if (line.empty() || line[0] != '!') lines.push_back(line);
+                text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+            }
+            if (lines.size() < 2) return std::nullopt;
+
+            std::string_view countLine = lines[1];
+            std::size_t countStart = countLine.find_first_not_of(" \t");
+            if (countStart == std::string_view::npos) return std::nullopt;
+            countLine.remove_prefix(countStart);
+            int count = 0;
+            auto [end, error] = std::from_chars(countLine.data(), countLine.data() + countLine.size(), count);
+            if (error != std::errc() || end == countLine.data() || count < 1 || lines.size() < 2 + static_cast<std::size_t>(count)) {
+                return std::nullopt;
+            }
+
+            // Scala lists steps 1..n, the last being the period; step 0 is implied
+            std::vector<double> cents = {0.0};
+            for (int i = 0; i < count; ++i) {
+                auto pitch = parseScalaPitch(lines[2 + i]);
+                if (!pitch) return std::nullopt;
+                cents.push_back(*pitch);
+            }
+            double period = cents.back();
+            cents.pop_back();
+            if (period <= 0.0) return std::nullopt;
+
+            return Tuning(std::string(lines[0]), std::move(cents), period, rootHz);
+        }
+
+        const std::string& getName() const { return name; }
+        int getStepsPerPeriod() const { return static_cast<int>(stepCents.size()); }
+        double getPeriodCents() const { return periodCents; }
+        double getReferenceHz() const { return referenceHz; }
+
+        // Cents above step 0 for any step, including those outside the first period
+        double getCents(int step) const {
+            int n = getStepsPerPeriod();
+            int period = step >= 0 ? step / n : -((-step + n - 1) / n);
+            return period * periodCents + stepCents[step - period * n];
+        }
+
+        double getFrequency(int step) const {
+            int index = step + TABLE_PERIODS * getStepsPerPeriod();
+            if (index >= 0 && index < static_cast<int>(frequencies.size())) {
+                return frequencies[index];
+            }
+            return computeFrequency(step);
+        }
+
+        // Step whose pitch is closest to the given number of cents above step 0
+        int nearestStep(double cents) const {
+            int n = getStepsPerPeriod();
+            int period = static_cast<int>(std::floor(cents / periodCents));
+            double withinPeriod = cents - period * periodCents;
+
+            int best = 0;
+            double bestDistance = std::numeric_limits<double>::max();
+            for (int step = 0; step <= n; ++step) {
+                double stepPosition = step < n ? stepCents[step] : periodCents;
+                double distance = std::abs(stepPosition - withinPeriod);
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = step;
+                }
+            }
+            return period * n + best;
+        }
+
+        // Number of steps that best approximates a 12-EDO interval
+        int stepsForSemitones(int semitones) const {
+            int octaves = semitones >= 0 ? semitones / 12 : -((-semitones + 11) / 12);
+            return octaves * getStepsPerPeriod() + semitoneSteps[semitones - octaves * 12];
+        }
+};
+
+// A scale or chord written as step offsets from a root in a given tuning.
+// The tuning must outlive it.
+class TunedScale {
+    private:
+        const Tuning* tuning;
+        int rootStep;
+        std::vector<int> offsets; // Steps above the root, starting with 0
+
+        TunedScale(const Tuning& scaleTuning, int root, std::vector<int> stepOffsets)
+            : tuning(&scaleTuning), rootStep(root), offsets(std::move(stepOffsets)) {}
+
+    public:
+        // Builds from consecutive step sizes, e.g. {5, 5, 3, 5, 5, 5, 3} for 31-EDO major
+        static TunedScale fromSteps(const Tuning& scaleTuning, int root, std::span<const int> steps) {
+            std::vector<int> stepOffsets = {0};
+            for (std::size_t i = 0; i + 1 < steps.size(); ++i) {
+                stepOffsets.push_back(stepOffsets.back() + steps[i]);
+            }
+            return TunedScale(scaleTuning, root, std::move(stepOffsets));
+        }
+
+        // Maps a catalog scale onto the nearest steps of the tuning
+        static TunedScale fromScale(const Tuning& scaleTuning, int root, const ScaleFormula& formula) {
+            std::vector<int> stepOffsets = {0};
+            int semitones = 0;
+            auto steps = formula.getSteps();
+            for (std::size_t i = 0; i + 1 < steps.size(); ++i) {
+                semitones += steps[i];
+                stepOffsets.push_back(scaleTuning.stepsForSemitones(semitones));
+            }
+            return TunedScale(scaleTuning, root, std::move(stepOffsets));
+        }
+
+        // Maps a catalog chord onto the nearest steps of the tuning
+        static TunedScale fromChord(const Tuning& scaleTuning, int root, const ChordFormula& formula) {
+            std::vector<int> stepOffsets = {0};
+            for (auto offset : formula.getOffsets()) {
+                stepOffsets.push_back(scaleTuning.stepsForSemitones(offset));
+            }
+            return TunedScale(scaleTuning, root, std::move(stepOffsets));
+        }
+
+        const Tuning& getTuning() const { return *tuning; }
+        int getRootStep() const { return rootStep; }
+        std::size_t size() const { return offsets.size(); }
+
+        int getStep(std::size_t degree) const { return rootStep + offsets[degree]; }
+        double getFrequency(std::size_t degree) const { return tuning->getFrequency(getStep(degree)); }
+        double getCentsAboveRoot(std::size_t degree) const {
+            return tuning->getCents(getStep(degree)) - tuning->getCents(rootStep);
+        }
+};
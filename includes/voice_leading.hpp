@@ -0,0 +1,149 @@
+#pragma once
+
+#include "common.hpp"
+#include "chord.hpp"
+#include "voicing.hpp"
+#include <cstdlib>
+
+struct VoiceLeadingOptions {
+    // Candidate voicings for every chord: a comping register, close and drop styles
+    VoicingOptions voicings{48, 76, 19,
+        (1u << static_cast<int>(VoicingStyle::Close)) | (1u << static_cast<int>(VoicingStyle::Open)) |
+        (1u << static_cast<int>(VoicingStyle::Drop2))};
+    int commonToneBonus = 2;    // Subtracted from the cost for every note held over unchanged
+    int maxLeap = 7;            // No single voice may move further than this (hard limit)
+    bool allowVoiceOverlap = false; // Whether a voice may pass where a neighbouring voice just was
+};
+
+struct VoiceLeading {
+    std::vector<Voicing> voicings; // One per chord, or none if some chord has no voicing at all
+    int totalMotion = 0;           // Semitones moved by all voices over the whole progression
+};
+
+// Chooses one voicing per chord so the voices move as little as possible in
+// total. Candidates come from Chord::voicings(); a Viterbi-style pass keeps
+// the cheapest path into every candidate of the current chord, so solving
+// takes chords x candidates^2 steps instead of exploring every combination.
+// Hard limits that would leave a chord unreachable are relaxed for that
+// one transition rather than failing the whole progression.
+class VoiceLeadingSolver {
+    private:
+        static constexpr int UNREACHABLE = std::numeric_limits<int>::max() / 2;
+
+        // Semitones moved going from one voicing to the next. Equal-sized
+        // voicings move voice by voice; otherwise each note goes to the
+        // nearest note of the other voicing, in whichever direction costs more.
+        static int motion(const Voicing& from, const Voicing& to) {
+            auto a = from.getNotes();
+            auto b = to.getNotes();
+            if (a.size() == b.size()) {
+                int total = 0;
+                for (std::size_t i = 0; i < a.size(); ++i) total += std::abs(b[i].getMidiValue() - a[i].getMidiValue());
+                return total;
+            }
+            auto nearest = [](Note note, std::span<const Note> others) {
+                int best = std::numeric_limits<int>::max();
+                for (Note other : others) best = std::min(best, std::abs(other.getMidiValue() - note.getMidiValue()));
+                return best;
+            };
+            int forward = 0, backward = 0;
+            for (Note note : a) forward += nearest(note, b);
+            for (Note note : b) backward += nearest(note, a);
+            return std::max(forward, backward);
+        }
+
+        // Whether the move breaks a hard limit: a leap that is too wide, or
+        // for same-sized voicings a voice overlapping its neighbour's previous note
+        static bool violates(const Voicing& from, const Voicing& to, const VoiceLeadingOptions& options) {
+            auto a = from.getNotes();
+            auto b = to.getNotes();
+            if (a.size() == b.size()) {
+                for (std::size_t i = 0; i < a.size(); ++i) {
+                    int next = b[i].getMidiValue();
+                    if (std::abs(next - a[i].getMidiValue()) > options.maxLeap) return true;
+                    if (options.allowVoiceOverlap) continue;
+                    if (i + 1 < a.size() && next > a[i + 1].getMidiValue()) return true;
+                    if (i > 0 && next < a[i - 1].getMidiValue()) return true;
+                }
+                return false;
+            }
+            for (Note note : b) {
+                bool close = false;
+                for (Note previous : a) close = close || std::abs(note.getMidiValue() - previous.getMidiValue()) <= options.maxLeap;
+                if (!close) return true;
+            }
+            return false;
+        }
+
+        static int heldNotes(const Voicing& from, const Voicing& to) {
+            int held = 0;
+            for (Note note : to.getNotes()) {
+                for (Note previous : from.getNotes()) held += note == previous;
+            }
+            return held;
+        }
+
+    public:
+        static VoiceLeading solve(std::span<const Chord> chords, const VoiceLeadingOptions& options = {}) {
+            VoiceLeading result;
+            if (chords.empty()) return result;
+
+            std::vector<std::vector<Voicing>> candidates(chords.size());
+            for (std::size_t i = 0; i < chords.size(); ++i) {
+                for (const Voicing& voicing : chords[i].voicings(options.voicings)) candidates[i].push_back(voicing);
+                // A register too narrow for the chord still gets a close voicing:
+                // one starting no more than an octave below the register, or
+                // failing that the highest-starting one there is
+                if (candidates[i].empty()) {
+                    VoicingOptions fallback{0, 127, 24, 1u << static_cast<int>(VoicingStyle::Close)};
+                    std::optional<Voicing> highest;
+                    for (const Voicing& voicing : chords[i].voicings(fallback)) {
+                        if (voicing.getLowest().getMidiValue() >= options.voicings.lowMidi - 12) {
+                            candidates[i].push_back(voicing);
+                            break;
+                        }
+                        if (!highest || voicing.getLowest().getMidiValue() > highest->getLowest().getMidiValue()) highest = voicing;
+                    }
+                    if (candidates[i].empty() && highest) candidates[i].push_back(*highest);
+                }
+                // Nothing can voice this chord, so there is no progression to lead through
+                if (candidates[i].empty()) return result;
+            }
+
+            std::vector<int> cost(candidates[0].size(), 0);
+            std::vector<std::vector<std::uint16_t>> previous(chords.size());
+
+            for (std::size_t step = 1; step < chords.size(); ++step) {
+                const auto& from = candidates[step - 1];
+                const auto& to = candidates[step];
+                std::vector<int> next(to.size(), UNREACHABLE);
+                previous[step].assign(to.size(), 0);
+
+                for (bool strict : {true, false}) {
+                    for (std::size_t j = 0; j < to.size(); ++j) {
+                        for (std::size_t i = 0; i < from.size(); ++i) {
+                            if (cost[i] >= UNREACHABLE || (strict && violates(from[i], to[j], options))) continue;
+                            int total = cost[i] + motion(from[i], to[j]) - options.commonToneBonus * heldNotes(from[i], to[j]);
+                            if (total < next[j]) {
+                                next[j] = total;
+                                previous[step][j] = static_cast<std::uint16_t>(i);
+                            }
+                        }
+                    }
+                    if (std::any_of(next.begin(), next.end(), [](int c) { return c < UNREACHABLE; })) break;
+                }
+                cost = std::move(next);
+            }
+
+            std::size_t best = static_cast<std::size_t>(std::min_element(cost.begin(), cost.end()) - cost.begin());
+            result.voicings.resize(chords.size());
+            for (std::size_t step = chords.size(); step-- > 0;) {
+                result.voicings[step] = candidates[step][best];
+                if (step > 0) best = previous[step][best];
+            }
+            for (std::size_t step = 1; step < chords.size(); ++step) {
+                result.totalMotion += motion(result.voicings[step - 1], result.voicings[step]);
+            }
+            return result;
+        }
+};
@@ -0,0 +1,236 @@
+#pragma once
+
+#include "common.hpp"
+#include "note.hpp"
+#include "catalog.hpp"
+#include "inline_list.hpp"
+#include <iterator>
+#include <ranges>
+
+enum class VoicingStyle : std::uint8_t {
+    Close,   // Every tone within one octave of the bass
+    Open,    // A triad with its middle voice raised an octave (for four voices this is Drop 2&4)
+    Drop2,   // Close position with the second voice from the top dropped an octave
+    Drop3,   // Third voice from the top dropped
+    Drop24,  // Second and fourth voices from the top dropped
+    Spread,  // Bass alone, the other tones in close position an octave or more above it
+    Count
+};
+
+constexpr std::string_view voicingStyleName(VoicingStyle style) {
+    constexpr std::array<std::string_view, static_cast<std::size_t>(VoicingStyle::Count)> NAMES = {
+        "Close", "Open", "Drop 2", "Drop 3", "Drop 2&4", "Spread"
+    };
+    return NAMES[static_cast<std::size_t>(style)];
+}
+
+struct VoicingOptions {
+    int lowMidi = 40;  // Lowest note allowed (E2, the guitar's open low E)
+    int highMidi = 88; // Highest note allowed
+    int maxSpan = 24;  // Largest distance from bottom to top note, in semitones
+    std::uint8_t styles = (1u << static_cast<int>(VoicingStyle::Count)) - 1; // Bit per VoicingStyle
+
+    constexpr bool allows(VoicingStyle style) const { return styles & (1u << static_cast<int>(style)); }
+};
+
+// One concrete voicing: up to eight MIDI notes, lowest first
+class Voicing {
+    public:
+        static constexpr std::size_t MAX_NOTES = 8;
+
+    private:
+        InlineList<Note, MAX_NOTES> notes;
+        std::uint8_t bassTone = 0; // Index of the lowest note in the chord formula, 0 = root
+        VoicingStyle style = VoicingStyle::Close;
+
+    public:
+        constexpr Voicing() = default;
+        constexpr Voicing(std::span<const std::int8_t> offsets, int bottom, int bassToneIndex, VoicingStyle voicingStyle)
+            : bassTone(static_cast<std::uint8_t>(bassToneIndex)), style(voicingStyle) {
+            for (std::int8_t offset : offsets) notes.push_back(Note(bottom + offset));
+        }
+
+        constexpr std::span<const Note> getNotes() const { return notes; }
+        constexpr std::size_t size() const { return notes.size(); }
+        constexpr Note getLowest() const { return notes.front(); }
+        constexpr Note getHighest() const { return notes.back(); }
+        constexpr int getSpan() const { return getHighest().getMidiValue() - getLowest().getMidiValue(); }
+        constexpr int getBassTone() const { return bassTone; }
+        constexpr VoicingStyle getStyle() const { return style; }
+};
+
+// Every voicing of a chord quality on a root, in each allowed style and with
+// each chord tone in the bass, at every octave that fits the register. Each
+// (style, bass tone) shape is built once and rejected whole if it exceeds
+// the span limit; octave placements are then walked lazily without
+// materializing anything.
+class VoicingRange : public std::ranges::view_interface<VoicingRange> {
+    private:
+        // Relative layout of one (style, bass tone) combination
+        struct Shape {
+            std::array<std::int8_t, Voicing::MAX_NOTES> offsets{}; // Ascending, offsets[0] == 0
+            std::uint8_t size = 0;
+            std::uint8_t bassPitchClass = 0; // Relative to the chord root
+            std::uint8_t bassTone = 0;
+        };
+
+        ChordType type = ChordType::Major;
+        std::uint8_t root = 0;
+        VoicingOptions options;
+
+        static constexpr int tonePitchClass(const ChordFormula& formula, int tone) {
+            return tone == 0 ? 0 : formula.offsets[tone - 1] % 12;
+        }
+
+        // Sorts offsets and rebases them so the lowest is 0
+        static constexpr void normalize(Shape& shape) {
+            std::sort(shape.offsets.begin(), shape.offsets.begin() + shape.size);
+            int lowest = shape.offsets[0];
+            for (std::size_t i = 0; i < shape.size; ++i) shape.offsets[i] = static_cast<std::int8_t>(shape.offsets[i] - lowest);
+            shape.bassPitchClass = static_cast<std::uint8_t>((shape.bassPitchClass + lowest + 120) % 12);
+        }
+
+        // Layout of the chord in a style over a given bass tone, or nullopt if
+        // the style needs more tones than the chord has or the span is too wide
+        static constexpr std::optional<Shape> shapeOf(const ChordFormula& formula, VoicingStyle style, int bassTone, int maxSpan) {
+            int size = static_cast<int>(formula.offsets.size()) + 1;
+            if (size > static_cast<int>(Voicing::MAX_NOTES)) return std::nullopt;
+            if (style == VoicingStyle::Open && size != 3) return std::nullopt;
+            if (style == VoicingStyle::Spread && size < 3) return std::nullopt;
+            bool drop = style == VoicingStyle::Drop2 || style == VoicingStyle::Drop3 || style == VoicingStyle::Drop24;
+            if (drop && size < 4) return std::nullopt;
+
+            // Close position: the other tones stacked upwards from the bass within an octave
+            Shape shape;
+            shape.size = static_cast<std::uint8_t>(size);
+            shape.bassPitchClass = static_cast<std::uint8_t>(tonePitchClass(formula, bassTone));
+            for (int tone = 0; tone < size; ++tone) {
+                shape.offsets[tone] = static_cast<std::int8_t>((tonePitchClass(formula, tone) - shape.bassPitchClass + 12) % 12);
+            }
+            std::sort(shape.offsets.begin(), shape.offsets.begin() + size);
+
+            switch (style) {
+                case VoicingStyle::Close:
+                case VoicingStyle::Count:
+                    break;
+                case VoicingStyle::Open:
+                    shape.offsets[1] = static_cast<std::int8_t>(shape.offsets[1] + 12);
+                    break;
+                case VoicingStyle::Drop2:
+                    shape.offsets[size - 2] = static_cast<std::int8_t>(shape.offsets[size - 2] - 12);
+                    break;
+                case VoicingStyle::Drop3:
+                    shape.offsets[size - 3] = static_cast<std::int8_t>(shape.offsets[size - 3] - 12);
+                    break;
+                case VoicingStyle::Drop24:
+                    shape.offsets[size - 2] = static_cast<std::int8_t>(shape.offsets[size - 2] - 12);
+                    shape.offsets[size - 4] = static_cast<std::int8_t>(shape.offsets[size - 4] - 12);
+                    break;
+                case VoicingStyle::Spread:
+                    for (int i = 1; i < size; ++i) shape.offsets[i] = static_cast<std::int8_t>(shape.offsets[i] + 12);
+                    break;
+            }
+            normalize(shape);
+
+            if (shape.offsets[size - 1] > maxSpan) return std::nullopt;
+            for (int tone = 0; tone < size; ++tone) {
+                if (tonePitchClass(formula, tone) == shape.bassPitchClass) shape.bassTone = static_cast<std::uint8_t>(tone);
+            }
+            return shape;
+        }
+
+    public:
+        class Iterator {
+            private:
+                ChordType type = ChordType::Major;
+                std::uint8_t root = 0;
+                VoicingOptions options;
+                int style = 0;
+                int bassTone = 0;
+                int bottom = 0;
+                Shape shape;
+
+                static constexpr int STYLE_COUNT = static_cast<int>(VoicingStyle::Count);
+
+                // Lowest bottom note of the current shape at or above the register floor
+                constexpr int firstBottom() const {
+                    int pitchClass = (root + shape.bassPitchClass) % 12;
+                    int low = options.lowMidi;
+                    return low + ((pitchClass - low) % 12 + 12) % 12;
+                }
+
+                constexpr bool fits() const { return bottom + shape.offsets[shape.size - 1] <= options.highMidi; }
+
+                // Moves to the next (style, bass tone) with a usable shape, starting from the current one
+                constexpr void settle() {
+                    const ChordFormula& formula = FormulaCatalog::get(type);
+                    for (; style < STYLE_COUNT; ++style, bassTone = 0) {
+                        if (!options.allows(static_cast<VoicingStyle>(style))) continue;
+                        for (; bassTone <= static_cast<int>(formula.offsets.size()); ++bassTone) {
+                            auto candidate = shapeOf(formula, static_cast<VoicingStyle>(style), bassTone, options.maxSpan);
+                            if (!candidate) continue;
+                            shape = *candidate;
+                            bottom = firstBottom();
+                            if (fits()) return;
+                        }
+                    }
+                }
+
+            public:
+                using value_type = Voicing;
+                using difference_type = std::ptrdiff_t;
+                using iterator_concept = std::forward_iterator_tag;
+
+                constexpr Iterator() = default;
+                constexpr Iterator(ChordType chordType, std::uint8_t rootPitchClass, VoicingOptions voicingOptions)
+                    : type(chordType), root(rootPitchClass), options(voicingOptions) {
+                    settle();
+                }
+
+                constexpr Voicing operator*() const {
+                    return Voicing({shape.offsets.data(), shape.size}, bottom, shape.bassTone, static_cast<VoicingStyle>(style));
+                }
+
+                constexpr Iterator& operator++() {
+                    bottom += 12;
+                    if (!fits()) {
+                        ++bassTone;
+                        settle();
+                    }
+                    return *this;
+                }
+
+                constexpr Iterator operator++(int) {
+                    Iterator previous = *this;
+                    ++*this;
+                    return previous;
+                }
+
+                constexpr bool operator==(const Iterator& other) const {
+                    return style == other.style && bassTone == other.bassTone && bottom == other.bottom;
+                }
+
+                constexpr bool operator==(std::default_sentinel_t) const { return style >= STYLE_COUNT; }
+        };
+
+        constexpr VoicingRange() = default;
+        constexpr VoicingRange(ChordType chordType, int rootPitchClass, VoicingOptions voicingOptions = {})
+            : type(chordType), root(static_cast<std::uint8_t>(((rootPitchClass % 12) + 12) % 12)), options(voicingOptions) {}
+
+        constexpr Iterator begin() const { return Iterator(type, root, options); }
+        constexpr std::default_sentinel_t end() const { return std::default_sentinel; }
+};
+
+static_assert(std::ranges::forward_range<VoicingRange>);
+static_assert(std::ranges::view<VoicingRange>);
+static_assert([] {
+    // Cmaj7 drop 2 over a G bass: G3 C4 E4 B4 gives offsets 0 5 9 16
+    VoicingRange voicings(ChordType::Major7, 0, {55, 72, 24, 1u << static_cast<int>(VoicingStyle::Drop2)});
+    for (Voicing voicing : voicings) {
+        if (voicing.getLowest().getMidiValue() == 55) {
+            auto notes = voicing.getNotes();
+            return notes[1].getMidiValue() == 60 && notes[2].getMidiValue() == 64 && notes[3].getMidiValue() == 71;
+        }
+    }
+    return false;
+}());
@@ -1,191 +1,24 @@
 #include "common.hpp"
-
-class Note {
-    private:
-        std::string name;
-        int midiValue; // MIDI value for the note (C4 = 60)
-
-    public:
-        Note() : name(""), midiValue(0) {}
-        Note(const std::string& noteName, int value) : name(noteName), midiValue(value) {}
-        
-        std::string getName() const { return name; }
-        int getMidiValue() const { return midiValue; }
-        
-        static const std::vector<std::string> ALL_NOTES;
-        
-        // Returns a note that is a specified number of semitones above this note
-        Note transpose(int semitones) const {
-            int newMidiValue = midiValue + semitones;
-            int noteIndex = (newMidiValue % 12);
-            std::string newName = ALL_NOTES[noteIndex];
-            return Note(newName, newMidiValue);
-        }
-};
-
-const std::vector<std::string> Note::ALL_NOTES = {"C", "C#/Db", "D", "D#/Eb", "E", "F", "F#/Gb", "G", "G#/Ab", "A", "A#/Bb", "B"};
-
-class Scale {
-    private:
-        std::string name;
-        std::vector<int> intervals; // Intervals in semitones
-        Note rootNote;
-
-    public:
-        Scale(const std::string& scaleName, const std::vector<int>& scaleIntervals, const Note& root)
-            : name(scaleName), intervals(scaleIntervals), rootNote(root) {}
-        
-        std::string getName() const { return name; }
-        
-        std::vector<Note> getNotes() const {
-            std::vector<Note> notes;
-            notes.push_back(rootNote);
-            
-            int currentPosition = rootNote.getMidiValue();
-            for (size_t i = 0; i < intervals.size(); ++i) {
-                currentPosition += intervals[i];
-                notes.push_back(Note(Note::ALL_NOTES[currentPosition % 12], currentPosition));
-            }
-            
-            return notes;
-        }
-        
-        void print() const {
-            std::cout << name << " Scale (" << rootNote.getName() << "): ";
-            auto notes = getNotes();
-            for (const auto& note : notes) {
-                std::cout << note.getName() << " ";
-            }
-            std::cout << std::endl;
-        }
-        
-        static Scale majorScale(const Note& root) {
-            return Scale(root.getName() + " Major", {2, 2, 1, 2, 2, 2, 1}, root);
-        }
-        
-        static Scale minorScale(const Note& root) {
-            return Scale(root.getName() + " Minor", {2, 1, 2, 2, 1, 2, 2}, root);
-        }
-        
-        static Scale pentatonicMajor(const Note& root) {
-            return Scale(root.getName() + " Pentatonic Major", {2, 2, 3, 2, 3}, root);
-        }
-        
-        static Scale pentatonicMinor(const Note& root) {
-            return Scale(root.getName() + " Pentatonic Minor", {3, 2, 2, 3, 2}, root);
-        }
-        
-        static Scale bluesScale(const Note& root) {
-            return Scale(root.getName() + " Blues", {3, 2, 1, 1, 3, 2}, root);
-        }
-};
-
-class Chord {
-    private:
-        std::string name;
-        std::vector<int> intervals; // Intervals in semitones from the root
-        Note rootNote;
-
-    public:
-        Chord(const std::string& chordName, const std::vector<int>& chordIntervals, const Note& root)
-            : name(chordName), intervals(chordIntervals), rootNote(root) {}
-        
-        std::string getName() const { return name; }
-        
-        std::vector<Note> getNotes() const {
-            std::vector<Note> notes;
-            notes.push_back(rootNote);
-            
-            // int currentPosition = rootNote.getMidiValue();
-            for (auto interval : intervals) {
-                notes.push_back(rootNote.transpose(interval));
-            }
-            
-            return notes;
-        }
-        
-        void print() const {
-            std::cout << name << " Chord: ";
-            auto notes = getNotes();
-            for (const auto& note : notes) {
-                std::cout << note.getName() << " ";
-            }
-            std::cout << std::endl;
-        }
-        
-        static Chord major(const Note& root) {
-            return Chord(root.getName() + " Major", {4, 7}, root);
-        }
-        
-        static Chord minor(const Note& root) {
-            return Chord(root.getName() + " Minor", {3, 7}, root);
-        }
-        
-        static Chord dominant7(const Note& root) {
-            return Chord(root.getName() + "7", {4, 7, 10}, root);
-        }
-        
-        static Chord major7(const Note& root) {
-            return Chord(root.getName() + "Maj7", {4, 7, 11}, root);
-        }
-        
-        static Chord minor7(const Note& root) {
-            return Chord(root.getName() + "min7", {3, 7, 10}, root);
-        }
-};
-
-class ChordProgression {
-    private:
-        std::string name;
-        std::vector<Chord> chords;
-
-    public:
-        ChordProgression(const std::string& progressionName, const std::vector<Chord>& progressionChords)
-            : name(progressionName), chords(progressionChords) {}
-        
-        void print() const {
-            std::cout << name << " Progression:" << std::endl;
-            for (size_t i = 0; i < chords.size(); ++i) {
-                std::cout << "  " << (i+1) << ". " << chords[i].getName() << std::endl;
-            }
-        }
-        
-        static ChordProgression createFromRomanNumerals(const Scale& scale, const std::vector<std::string>& numerals, const std::string& name) {
-            std::vector<Chord> progressionChords;
-            auto scaleNotes = scale.getNotes();
-            
-            for (const auto& numeral : numerals) {
-                int degree = 0;
-                Chord chord(numeral, {}, scaleNotes[0]);
-                
-                if (numeral == "I" || numeral == "i") degree = 0;
-                else if (numeral == "II" || numeral == "ii") degree = 1;
-                else if (numeral == "III" || numeral == "iii") degree = 2;
-                else if (numeral == "IV" || numeral == "iv") degree = 3;
-                else if (numeral == "V" || numeral == "v") degree = 4;
-                else if (numeral == "VI" || numeral == "vi") degree = 5;
-                else if (numeral == "VII" || numeral == "vii") degree = 6;
-                
-                if (numeral.find('7') != std::string::npos) {
-                    if (std::isupper(numeral[0])) {
-                        chord = Chord::dominant7(scaleNotes[degree]);
-                    } else {
-                        chord = Chord::minor7(scaleNotes[degree]);
-                    }
-                } else {
-                    if (std::isupper(numeral[0])) {
-                        chord = Chord::major(scaleNotes[degree]);
-                    } else {
-                        chord = Chord::minor(scaleNotes[degree]);
-                    }
-                }
-                
-                progressionChords.push_back(chord);
-            }
-            
-            return ChordProgression(name, progressionChords);
-        }
-};
+#include "note.hpp"
+#include "pitch_class_set.hpp"
+#include "scale.hpp"
+#include "chord.hpp"
+#include "symbol_parser.hpp"
+#include "tuning.hpp"
+#include "scale_catalog.hpp"
+#include "scale_finder.hpp"
+#include "scale_similarity.hpp"
+#include "scale_fitter.hpp"
+#include "chord_identifier.hpp"
+#include "voice_leading.hpp"
+#include "diatonic.hpp"
+#include "roman_numeral.hpp"
+#include "progression.hpp"
+#include "key_finder.hpp"
+#include "harmony_analyzer.hpp"
+#include "progression_generator.hpp"
+#include "reharmonizer.hpp"
+#include <sstream>
 
 // TODO: change to private, i.e., implement getters/setters for fretboard
 class GuitarFretboard {
@@ -219,9 +52,7 @@ class GuitarFretboard {
                 fretboard[string].resize(numFrets + 1); // +1 for the open string
                 
                 for (int fret = 0; fret <= numFrets; ++fret) {
-                    int midiValue = openStringMidi[string] + fret;
-                    int noteIndex = midiValue % 12;
-                    fretboard[string][fret] = Note(Note::ALL_NOTES[noteIndex], midiValue);
+                    fretboard[string][fret] = Note(openStringMidi[string] + fret);
                 }
             }
         }
@@ -252,61 +83,25 @@ class GuitarFretboard {
         }
         
         void highlightScale(const Scale& scale) const {
-            auto scaleNotes = scale.getNotes();
-            std::vector<std::string> noteNames;
-            
-            for (const auto& note : scaleNotes) {
-                noteNames.push_back(note.getName());
-            }
-            
-            // Print fret numbers
-            std::cout << "    ";
-            for (int fret = 0; fret <= 12; ++fret) {
-                std::cout << std::setw(5) << fret;
-            }
-            std::cout << std::endl;
-            
-            // Print a line
-            std::cout << "    ";
-            for (int fret = 0; fret <= 12; ++fret) {
-                std::cout << "-----";
-            }
-            std::cout << std::endl;
-            
-            // Print each string with scale notes highlighted
-            for (int string = 0; string < numStrings; ++string) {
-                std::cout << standardTuning[string] << " | ";
-                for (int fret = 0; fret <= 12; ++fret) {
-                    std::string noteName = fretboard[string][fret].getName();
-                    bool isInScale = false;
-                    
-                    for (const auto& scaleName : noteNames) {
-                        if (noteName == scaleName || 
-                            (noteName.find(scaleName) != std::string::npos) ||
-                            (scaleName.find(noteName) != std::string::npos)) {
-                            isInScale = true;
-                            break;
-                        }
-                    }
-                    
-                    if (isInScale) {
-                        std::cout << std::setw(5) << "[" + noteName + "]";
-                    } else {
-                        std::cout << std::setw(5) << ".";
-                    }
-                }
-                std::cout << std::endl;
+            std::array<SpelledPitch, 12> spellings;
+            for (int pc = 0; pc < 12; ++pc) {
+                spellings[pc] = scale.spell(pc);
             }
+            highlightPitchClasses(scale.getPitchClassSet(), spellings);
         }
         
         void highlightChord(const Chord& chord) const {
-            auto chordNotes = chord.getNotes();
-            std::vector<std::string> noteNames;
-            
-            for (const auto& note : chordNotes) {
-                noteNames.push_back(note.getName());
+            std::array<SpelledPitch, 12> spellings;
+            int rootPitchClass = chord.getRoot().getPitchClass();
+            spellings[rootPitchClass] = chord.getRootSpelling();
+            for (auto interval : chord.getIntervals()) {
+                spellings[(rootPitchClass + interval) % 12] = chord.spellTone(interval);
             }
-            
+            highlightPitchClasses(chord.getPitchClassSet(), spellings);
+        }
+        
+        // Brackets every fret whose pitch class is in the set, named by the given spellings
+        void highlightPitchClasses(PitchClassSet highlighted, const std::array<SpelledPitch, 12>& spellings) const {
             // Print fret numbers
             std::cout << "    ";
             for (int fret = 0; fret <= 12; ++fret) {
@@ -321,24 +116,14 @@ class GuitarFretboard {
             }
             std::cout << std::endl;
             
-            // Print each string with chord notes highlighted
+            // Print each string with the highlighted notes bracketed
             for (int string = 0; string < numStrings; ++string) {
                 std::cout << standardTuning[string] << " | ";
                 for (int fret = 0; fret <= 12; ++fret) {
-                    std::string noteName = fretboard[string][fret].getName();
-                    bool isInChord = false;
+                    const Note& note = fretboard[string][fret];
                     
-                    for (const auto& chordName : noteNames) {
-                        if (noteName == chordName || 
-                            (noteName.find(chordName) != std::string::npos) ||
-                            (chordName.find(noteName) != std::string::npos)) {
-                            isInChord = true;
-                            break;
-                        }
-                    }
-                    
-                    if (isInChord) {
-                        std::cout << std::setw(5) << "[" + noteName + "]";
+                    if (highlighted.contains(note)) {
+                        std::cout << std::setw(5) << "[" + std::string(spellings[note.getPitchClass()].getName()) + "]";
                     } else {
                         std::cout << std::setw(5) << ".";
                     }
@@ -386,7 +171,7 @@ class IntervalTrainer {
             for (int i = 1; i <= 5; ++i) {
                 // Generate random starting note
                 int noteIndex = std::rand() % 12;
-                Note startNote(Note::ALL_NOTES[noteIndex], 60 + noteIndex);
+                Note startNote(60 + noteIndex);
                 
                 // Generate random interval (1-12 semitones)
                 int intervalSize = 1 + std::rand() % 12;
@@ -411,8 +196,8 @@ class IntervalTrainer {
 
 class EarTrainer {
     private:
-        std::vector<std::string> chordQualities = {
-            "Major", "Minor", "Dominant 7", "Major 7", "Minor 7"
+        std::vector<ChordType> chordQualities = {
+            ChordType::Major, ChordType::Minor, ChordType::Dominant7, ChordType::Major7, ChordType::Minor7
         };
 
     public:
@@ -426,37 +211,25 @@ class EarTrainer {
             for (int i = 1; i <= 5; ++i) {
                 // Generate random root note
                 int noteIndex = std::rand() % 12;
-                Note rootNote(Note::ALL_NOTES[noteIndex], 60 + noteIndex);
+                Note rootNote(60 + noteIndex);
                 
                 // Generate random chord quality
                 int qualityIndex = std::rand() % chordQualities.size();
-                std::string quality = chordQualities[qualityIndex];
-                
-                Chord chord("", {}, rootNote);
-                if (quality == "Major") {
-                    chord = Chord::major(rootNote);
-                } else if (quality == "Minor") {
-                    chord = Chord::minor(rootNote);
-                } else if (quality == "Dominant 7") {
-                    chord = Chord::dominant7(rootNote);
-                } else if (quality == "Major 7") {
-                    chord = Chord::major7(rootNote);
-                } else if (quality == "Minor 7") {
-                    chord = Chord::minor7(rootNote);
-                }
+                Chord chord(chordQualities[qualityIndex], rootNote);
+                std::string_view quality = chord.getFormula().name;
                 
                 std::cout << "Exercise " << i << ": Identify the quality of this chord: ";
                 
                 // Print chord notes
-                auto notes = chord.getNotes();
-                for (const auto& note : notes) {
-                    std::cout << note.getName() << " ";
+                std::cout << chord.getRootSpelling().getName() << " ";
+                for (auto interval : chord.getIntervals()) {
+                    std::cout << chord.spellTone(interval).getName() << " ";
                 }
                 
                 std::cout << "(Press Enter to see answer)";
                 std::cin.ignore();
                 
-                std::cout << "Answer: " << rootNote.getName() << " " << quality << std::endl;
+                std::cout << "Answer: " << chord.getRootSpelling().getName() << " " << quality << std::endl;
             }
         }
 };
@@ -466,9 +239,81 @@ class MusicTheoryCompanion {
         GuitarFretboard fretboard;
         IntervalTrainer intervalTrainer;
         EarTrainer earTrainer;
+        SimilarityMatrix similarity;
+        
+        // Prompts for a note name such as C, f#, Bb or Ebb; returns nullopt if it doesn't parse
+        std::optional<SpelledPitch> readNote(const std::string& prompt) const {
+            std::string input;
+            std::cout << prompt;
+            std::cin >> input;
+            return SymbolParser::parseNote(input);
+        }
+        
+        // Prompts for a line of space-separated notes; returns nullopt after
+        // reporting the first one that doesn't parse. Pass afterLine = true
+        // when the previous input was read with getline, so there is no rest
+        // of line to skip.
+        std::optional<std::vector<SpelledPitch>> readNoteList(const std::string& prompt, bool afterLine = false) const {
+            std::string line;
+            std::cout << prompt;
+            if (!afterLine) std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            std::getline(std::cin, line);
+            
+            std::vector<SpelledPitch> notes;
+            std::string_view remaining = line;
+            while (!remaining.empty()) {
+                std::size_t start = remaining.find_first_not_of(' ');
+                if (start == std::string_view::npos) break;
+                remaining.remove_prefix(start);
+                std::size_t end = std::min(remaining.find(' '), remaining.size());
+                auto note = SymbolParser::parseNote(remaining.substr(0, end));
+                if (!note) {
+                    std::cout << "Invalid note \"" << remaining.substr(0, end) << "\". Please try again." << std::endl;
+                    return std::nullopt;
+                }
+                notes.push_back(*note);
+                remaining.remove_prefix(end);
+            }
+            return notes;
+        }
+        
+        // Prompts for a line of space-separated chord symbols; returns nullopt
+        // after reporting the first one that doesn't parse
+        std::optional<std::vector<Chord>> readChordChart(const std::string& prompt) const {
+            std::string line;
+            std::cout << prompt;
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            std::getline(std::cin, line);
+            
+            std::vector<Chord> chart;
+            std::vector<std::string> slashChords;
+            std::string_view remaining = line;
+            while (!remaining.empty()) {
+                std::size_t start = remaining.find_first_not_of(' ');
+                if (start == std::string_view::npos) break;
+                remaining.remove_prefix(start);
+                std::size_t end = std::min(remaining.find(' '), remaining.size());
+                auto parsed = SymbolParser::parseChord(remaining.substr(0, end));
+                if (!parsed) {
+                    std::cout << "Invalid chord \"" << remaining.substr(0, end) << "\". Please try again." << std::endl;
+                    return std::nullopt;
+                }
+                chart.push_back(Chord(parsed->type, Note(60 + parsed->root.getPitchClass()), parsed->root));
+                if (parsed->bass) slashChords.push_back(std::string(remaining.substr(0, end)) + " as " + chart.back().getName());
+                remaining.remove_prefix(end);
+            }
+            // Chords are analyzed by root and quality alone, so say what became of the basses
+            if (!slashChords.empty()) {
+                std::cout << "Note: slash basses are ignored, reading";
+                for (std::size_t i = 0; i < slashChords.size(); ++i) std::cout << (i ? ", " : " ") << slashChords[i];
+                std::cout << "." << std::endl;
+            }
+            return chart;
+        }
 
     public:
-        MusicTheoryCompanion() : fretboard(24) {}
+        MusicTheoryCompanion()
+            : fretboard(24), similarity(SimilarityMatrix::loadOrCompute(SimilarityMatrix::defaultCachePath())) {}
         
         void showMainMenu() {
             int choice = 0;
@@ -550,34 +395,28 @@ class MusicTheoryCompanion {
         void showScalesMenu() {
             int choice = 0;
             
-            while (choice != 6) {
+            while (choice != 11) {
                 std::cout << "\n=== Scales Explorer ===" << std::endl;
                 std::cout << "1. Major Scales" << std::endl;
                 std::cout << "2. Minor Scales" << std::endl;
                 std::cout << "3. Pentatonic Major Scales" << std::endl;
                 std::cout << "4. Pentatonic Minor Scales" << std::endl;
                 std::cout << "5. Blues Scales" << std::endl;
-                std::cout << "6. Back to Main Menu" << std::endl;
+                std::cout << "6. Any Scale by Name (e.g., Dorian, Whole Tone)" << std::endl;
+                std::cout << "7. Find Scales Containing Notes" << std::endl;
+                std::cout << "8. Fit Scales to a Melody" << std::endl;
+                std::cout << "9. Find the Key of a Melody" << std::endl;
+                std::cout << "10. A Scale in Another Tuning (e.g., 19, 24 or 31 Notes per Octave)" << std::endl;
+                std::cout << "11. Back to Main Menu" << std::endl;
                 std::cout << "Enter your choice: ";
                 std::cin >> choice;
                 
                 if (choice >= 1 && choice <= 5) {
-                    std::string rootNote;
-                    std::cout << "Enter root note (e.g., C, F#, Bb): ";
-                    std::cin >> rootNote;
+                    auto rootSpelling = readNote("Enter root note (e.g., C, F#, Bb): ");
                     
-                    // Find the MIDI value for the root note
-                    int rootIndex = -1;
-                    for (size_t i = 0; i < Note::ALL_NOTES.size(); ++i) {
-                        if (Note::ALL_NOTES[i].find(rootNote) != std::string::npos) {
-                            rootIndex = i;
-                            break;
-                        }
-                    }
-                    
-                    if (rootIndex != -1) {
-                        Note root(Note::ALL_NOTES[rootIndex], 60 + rootIndex);
-                        Scale scale("", {}, root);
+                    if (rootSpelling) {
+                        Note root(60 + rootSpelling->getPitchClass());
+                        Scale scale = Scale::majorScale(root);
                         
                         switch (choice) {
                             case 1:
@@ -598,46 +437,279 @@ class MusicTheoryCompanion {
                         }
                         
                         scale.print();
+                        
+                        std::string diatonic;
+                        for (int degree = 0; degree < static_cast<int>(scale.getIntervals().size()); ++degree) {
+                            auto triad = DiatonicHarmony::triad(scale, degree);
+                            auto seventh = DiatonicHarmony::seventh(scale, degree);
+                            if (!triad && !seventh) continue;
+                            diatonic += " " + (triad ? triad->getName() : "-") + " (" + (seventh ? seventh->getName() : "-") + ")";
+                        }
+                        if (!diatonic.empty()) {
+                            std::cout << "Diatonic chords:" << diatonic << std::endl;
+                        }
+                        
                         std::cout << "\nScale positions on fretboard:" << std::endl;
                         fretboard.highlightScale(scale);
                     } else {
                         std::cout << "Invalid root note. Please try again." << std::endl;
                     }
+                } else if (choice == 6) {
+                    showCatalogScale();
+                } else if (choice == 7) {
+                    findScalesContainingNotes();
+                } else if (choice == 8) {
+                    fitScalesToMelody();
+                } else if (choice == 9) {
+                    findKeyOfMelody();
+                } else if (choice == 10) {
+                    showTunedScale();
+                }
+            }
+        }
+        
+        // Maps a catalog scale onto the nearest steps of an equal division of
+        // the octave and lists how far each degree moves from 12-EDO
+        void showTunedScale() const {
+            auto rootSpelling = readNote("Enter root note (e.g., C, F#, Bb): ");
+            if (!rootSpelling) {
+                std::cout << "Invalid root note. Please try again." << std::endl;
+                return;
+            }
+            
+            int divisions = 0;
+            std::cout << "Enter the number of equal steps per octave (e.g., 19, 24, 31): ";
+            std::cin >> divisions;
+            if (divisions < 5 || divisions > 72) {
+                std::cout << "Please choose between 5 and 72 steps per octave." << std::endl;
+                return;
+            }
+            
+            for (std::size_t i = 0; i < FormulaCatalog::SCALES.size(); ++i) {
+                std::cout << (i + 1) << ". " << FormulaCatalog::SCALES[i].name << std::endl;
+            }
+            std::size_t scaleChoice = 0;
+            std::cout << "Choose a scale: ";
+            std::cin >> scaleChoice;
+            if (scaleChoice < 1 || scaleChoice > FormulaCatalog::SCALES.size()) {
+                std::cout << "Invalid choice. Please try again." << std::endl;
+                return;
+            }
+            const ScaleFormula& formula = FormulaCatalog::SCALES[scaleChoice - 1];
+            
+            Tuning tuning = Tuning::equalDivision(divisions);
+            int root = rootSpelling->getPitchClass();
+            TunedScale scale = TunedScale::fromScale(tuning, tuning.stepsForSemitones(root), formula);
+            
+            std::cout << rootSpelling->getName() << " " << formula.name << " in " << tuning.getName() << ":" << std::endl;
+            int semitones = 0;
+            for (std::size_t degree = 0; degree < scale.size(); ++degree) {
+                double cents = scale.getCentsAboveRoot(degree);
+                std::ostringstream line;
+                line << std::fixed << std::setprecision(1) << "  " << (degree + 1) << ": step " << scale.getStep(degree) << ", "
+                     << cents << " cents (" << std::showpos << cents - semitones * 100.0 << std::noshowpos << " from 12-EDO), "
+                     << std::setprecision(2) << scale.getFrequency(degree) << " Hz";
+                std::cout << line.str() << std::endl;
+                semitones += formula.getSteps()[degree];
+            }
+        }
+        
+        void showCatalogScale() {
+            auto rootSpelling = readNote("Enter root note (e.g., C, F#, Bb): ");
+            if (!rootSpelling) {
+                std::cout << "Invalid root note. Please try again." << std::endl;
+                return;
+            }
+            
+            std::string scaleName;
+            std::cout << "Enter scale name: ";
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            std::getline(std::cin, scaleName);
+            
+            auto shape = ScaleCatalog::find(scaleName);
+            if (!shape) {
+                std::cout << "Unknown scale \"" << scaleName << "\". Please try again." << std::endl;
+                return;
+            }
+            
+            const ScaleEntry& entry = ScaleCatalog::get(*shape);
+            int root = rootSpelling->getPitchClass();
+            bool minor = shape->contains(3) && !shape->contains(4);
+            Key key{minor ? ScaleType::Minor : ScaleType::Major, static_cast<std::uint8_t>(root)};
+            
+            std::array<SpelledPitch, 12> spellings;
+            for (int pc = 0; pc < 12; ++pc) {
+                spellings[pc] = Speller::spell(key, pc);
+            }
+            spellings[root] = *rootSpelling;
+            
+            std::cout << rootSpelling->getName() << " " << ScaleCatalog::nameOf(*shape) << " Scale: ";
+            shape->forEach([&](int offset) {
+                std::cout << spellings[(root + offset) % 12].getName() << " ";
+            });
+            std::cout << std::endl;
+            
+            std::string diatonic;
+            int degree = 0;
+            shape->forEach([&](int offset) {
+                auto chords = DiatonicHarmony::get(*shape, degree++);
+                if (!chords || (!chords->triad && !chords->seventh)) return;
+                int pc = (root + offset) % 12;
+                auto name = [&](std::optional<ChordType> type) {
+                    return type ? Chord(*type, Note(60 + pc)).spelledAs(spellings[pc]).getName() : std::string("-");
+                };
+                diatonic += " " + name(chords->triad) + " (" + name(chords->seventh) + ")";
+            });
+            if (!diatonic.empty()) {
+                std::cout << "Diatonic chords:" << diatonic << std::endl;
+            }
+            
+            PitchClassSet parent(entry.modeParent);
+            if (entry.modeIndex != 0 && !ScaleCatalog::nameOf(parent).empty()) {
+                std::cout << "Mode " << (entry.modeIndex + 1) << " of " << ScaleCatalog::nameOf(parent) << std::endl;
+            }
+            
+            std::cout << "Modes:";
+            for (const Mode& mode : ModeRange(*shape, Note(60 + root))) {
+                if (mode.getDegree() == 0) continue;
+                std::string_view modeName = mode.getName();
+                std::cout << " " << spellings[mode.getRoot().getPitchClass()].getName() << " "
+                          << (modeName.empty() ? "(unnamed)" : modeName) << ";";
+            }
+            std::cout << std::endl;
+            
+            if (auto index = SimilarityMatrix::indexOf(*shape, root)) {
+                std::cout << "Related scales:" << std::endl;
+                for (std::size_t other : similarity.related(*index, 5)) {
+                    const ScaleSimilarity& distance = similarity.at(*index, other);
+                    std::cout << "  " << spellings[SimilarityMatrix::getRoot(other)].getName() << " " << SimilarityMatrix::getName(other)
+                              << " (" << static_cast<int>(distance.commonTones) << " common tones, "
+                              << static_cast<int>(distance.voiceLeading) << " semitones of voice leading)" << std::endl;
                 }
             }
+            
+            std::cout << "\nScale positions on fretboard:" << std::endl;
+            fretboard.highlightPitchClasses(shape->transpose(root), spellings);
+        }
+        
+        void findScalesContainingNotes() const {
+            auto played = readNoteList("Enter the notes you are playing separated by spaces (e.g., C E G Bb): ");
+            if (!played) return;
+            
+            PitchClassSet notes;
+            for (const SpelledPitch& note : *played) {
+                notes = notes.with(note.getPitchClass());
+            }
+            
+            auto matches = ScaleFinder::instance().find(notes);
+            if (matches.empty()) {
+                std::cout << "No named scale contains all of those notes." << std::endl;
+                return;
+            }
+            
+            constexpr std::size_t MAX_SHOWN = 15;
+            std::cout << "Scales containing those notes (" << matches.size() << " found, best first):" << std::endl;
+            for (std::size_t i = 0; i < std::min(matches.size(), MAX_SHOWN); ++i) {
+                const ScaleMatch& match = matches[i];
+                PitchClassSet shape = match.getPitchClassSet().transpose(-match.root);
+                bool minor = shape.contains(3) && !shape.contains(4);
+                Key key{minor ? ScaleType::Minor : ScaleType::Major, match.root};
+                std::cout << "  " << std::setw(2) << (i + 1) << ". " << Speller::tonic(key).getName() << " " << match.getName()
+                          << " (+" << static_cast<int>(match.extraNotes) << " notes)" << std::endl;
+            }
+        }
+        
+        void fitScalesToMelody() const {
+            auto melody = readNoteList("Enter a melody as notes separated by spaces (e.g., E D C D E E E): ");
+            if (!melody || melody->empty()) return;
+            
+            constexpr std::size_t WINDOW = 8;
+            constexpr std::size_t MAX_SHOWN = 3;
+            ScaleFitter fitter(WINDOW);
+            std::cout << "Best-fitting scales over the last " << WINDOW << " notes:" << std::endl;
+            for (const SpelledPitch& note : *melody) {
+                fitter.push(note.getPitchClass());
+                std::cout << "  " << std::setw(3) << note.getName() << " ->";
+                for (const ScaleFit& fit : fitter.best(MAX_SHOWN)) {
+                    PitchClassSet shape = fit.getPitchClassSet().transpose(-fit.root);
+                    bool minor = shape.contains(3) && !shape.contains(4);
+                    Key key{minor ? ScaleType::Minor : ScaleType::Major, fit.root};
+                    std::cout << "  " << Speller::tonic(key).getName() << " " << fit.getName();
+                    if (fit.notesOutside > 0) std::cout << " (" << fit.notesOutside << " outside)";
+                    std::cout << ";";
+                }
+                std::cout << std::endl;
+            }
+        }
+        
+        // One line per event: the running best guess and how far it leads
+        static void printKeyEstimate(const KeyFinder& finder) {
+            auto estimate = finder.best();
+            if (!estimate) {
+                std::cout << " (not enough yet)" << std::endl;
+                return;
+            }
+            // Formatted apart so std::cout keeps its default float format
+            std::ostringstream scores;
+            scores << std::fixed << std::setprecision(2) << "  r=" << estimate->correlation << " (+" << estimate->confidence << ")";
+            std::cout << " " << estimate->getName() << scores.str() << std::endl;
+        }
+        
+        // The final answer from both profiles, so their disagreements show
+        template <typename Event>
+        static void printKeyRanking(const std::vector<Event>& events) {
+            constexpr std::size_t MAX_SHOWN = 3;
+            for (int p = 0; p < static_cast<int>(KeyProfile::Count); ++p) {
+                KeyFinder finder(static_cast<KeyProfile>(p), 0);
+                for (const Event& event : events) finder.push(event);
+                std::cout << std::left << std::setw(19) << keyProfileName(static_cast<KeyProfile>(p)) << std::right << ":";
+                for (const KeyEstimate& estimate : finder.ranked(MAX_SHOWN)) {
+                    std::ostringstream correlation;
+                    correlation << std::fixed << std::setprecision(2) << estimate.correlation;
+                    std::cout << "  " << estimate.getName() << " (" << correlation.str() << ");";
+                }
+                std::cout << std::endl;
+            }
+        }
+        
+        void findKeyOfMelody() const {
+            auto melody = readNoteList("Enter a melody as notes separated by spaces (e.g., G A B C D E F# G): ");
+            if (!melody || melody->empty()) return;
+            
+            KeyFinder finder;
+            std::vector<Note> notes;
+            std::cout << "Key estimate as the melody unfolds:" << std::endl;
+            for (const SpelledPitch& note : *melody) {
+                notes.push_back(Note(60 + note.getPitchClass()));
+                finder.push(notes.back());
+                std::cout << "  " << std::setw(3) << note.getName() << " ->";
+                printKeyEstimate(finder);
+            }
+            std::cout << "Whole melody:" << std::endl;
+            printKeyRanking(notes);
         }
         
         void showChordsMenu() {
             int choice = 0;
             
-            while (choice != 6) {
+            while (choice != 7) {
                 std::cout << "\n=== Chords Explorer ===" << std::endl;
                 std::cout << "1. Major Chords" << std::endl;
                 std::cout << "2. Minor Chords" << std::endl;
                 std::cout << "3. Dominant 7th Chords" << std::endl;
                 std::cout << "4. Major 7th Chords" << std::endl;
                 std::cout << "5. Minor 7th Chords" << std::endl;
-                std::cout << "6. Back to Main Menu" << std::endl;
+                std::cout << "6. Identify a Chord from Notes" << std::endl;
+                std::cout << "7. Back to Main Menu" << std::endl;
                 std::cout << "Enter your choice: ";
                 std::cin >> choice;
                 
                 if (choice >= 1 && choice <= 5) {
-                    std::string rootNote;
-                    std::cout << "Enter root note (e.g., C, F#, Bb): ";
-                    std::cin >> rootNote;
-                    
-                    // Find the MIDI value for the root note
-                    int rootIndex = -1;
-                    for (size_t i = 0; i < Note::ALL_NOTES.size(); ++i) {
-                        if (Note::ALL_NOTES[i].find(rootNote) != std::string::npos) {
-                            rootIndex = i;
-                            break;
-                        }
-                    }
+                    auto rootSpelling = readNote("Enter root note (e.g., C, F#, Bb): ");
                     
-                    if (rootIndex != -1) {
-                        Note root(Note::ALL_NOTES[rootIndex], 60 + rootIndex);
-                        Chord chord("", {}, root);
+                    if (rootSpelling) {
+                        Note root(60 + rootSpelling->getPitchClass());
+                        Chord chord = Chord::major(root);
                         
                         switch (choice) {
                             case 1:
@@ -657,80 +729,282 @@ class MusicTheoryCompanion {
                                 break;
                         }
                         
+                        chord = chord.spelledAs(*rootSpelling);
                         chord.print();
+                        
+                        std::cout << "\nVoicings:" << std::endl;
+                        VoicingStyle shown = VoicingStyle::Count;
+                        for (const Voicing& voicing : chord.voicings()) {
+                            if (voicing.getStyle() == shown) continue;
+                            shown = voicing.getStyle();
+                            std::cout << "  " << std::left << std::setw(10) << voicingStyleName(shown) << std::right;
+                            for (Note note : voicing.getNotes()) {
+                                std::cout << " " << chord.spellPitchClass(note.getPitchClass()).getName() << (note.getMidiValue() / 12 - 1);
+                            }
+                            std::cout << std::endl;
+                        }
                         std::cout << "\nChord positions on fretboard:" << std::endl;
                         fretboard.highlightChord(chord);
                     } else {
                         std::cout << "Invalid root note. Please try again." << std::endl;
                     }
+                } else if (choice == 6) {
+                    identifyChord();
                 }
             }
         }
         
+        void identifyChord() const {
+            auto played = readNoteList("Enter the notes from lowest to highest (e.g., E G C): ");
+            if (!played || played->empty()) return;
+            
+            PitchClassSet notes;
+            for (const SpelledPitch& note : *played) {
+                notes = notes.with(note.getPitchClass());
+            }
+            
+            auto matches = ChordIdentifier::instance().identify(notes, played->front().getPitchClass());
+            if (matches.empty()) {
+                std::cout << "Those notes don't form a known chord." << std::endl;
+                return;
+            }
+            
+            std::cout << "Possible chord names (best first):" << std::endl;
+            for (const ChordMatch& match : matches) {
+                std::cout << "  " << match.getName() << std::endl;
+            }
+        }
+        
+        struct ProgressionPreset {
+            std::string_view title;
+            ScaleType mode;
+            RomanProgression numerals;
+        };
+        
+        static constexpr std::array<ProgressionPreset, 4> PROGRESSION_PRESETS = {{
+            {"I-IV-V", ScaleType::Major, "I-IV-V"_roman},
+            {"I-V-vi-IV (Pop)", ScaleType::Major, "I-V-vi-IV"_roman},
+            {"ii-V-I (Jazz)", ScaleType::Major, "ii7-V7-Imaj7"_roman},
+            {"i-iv-v", ScaleType::Minor, "i-iv-v"_roman},
+        }};
+        
+        // Prompts for a line of numerals in a major key; nullopt after reporting a parse failure
+        std::optional<DegreeProgression> readRomanNumerals() const {
+            std::string line;
+            std::cout << "Enter numerals for a major key (e.g., I-vi-ii7-V7/V-V7-I, bVII, viiø7, V65): ";
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            std::getline(std::cin, line);
+            
+            auto numerals = RomanNumeralParser::parseProgression<64>(line);
+            if (!numerals || numerals->empty()) {
+                std::cout << "Couldn't read those numerals. Please try again." << std::endl;
+                return std::nullopt;
+            }
+            return DegreeProgression::fromRomanNumerals(ScaleType::Major, *numerals);
+        }
+        
         void showProgressionsMenu() {
             int choice = 0;
             
-            while (choice != 5) {
+            while (choice != 11) {
                 std::cout << "\n=== Chord Progressions ===" << std::endl;
                 std::cout << "1. I-IV-V (Major)" << std::endl;
                 std::cout << "2. I-V-vi-IV (Pop)" << std::endl;
                 std::cout << "3. ii-V-I (Jazz)" << std::endl;
                 std::cout << "4. i-iv-v (Minor)" << std::endl;
-                std::cout << "5. Back to Main Menu" << std::endl;
+                std::cout << "5. Your Own Roman Numerals" << std::endl;
+                std::cout << "6. Your Own Roman Numerals in All 12 Keys" << std::endl;
+                std::cout << "7. Find the Key of a Chord Chart" << std::endl;
+                std::cout << "8. Analyze a Chord Chart (Roman Numerals and Key Changes)" << std::endl;
+                std::cout << "9. Generate Practice Progressions" << std::endl;
+                std::cout << "10. Reharmonize a Chord Chart" << std::endl;
+                std::cout << "11. Back to Main Menu" << std::endl;
                 std::cout << "Enter your choice: ";
                 std::cin >> choice;
                 
-                if (choice >= 1 && choice <= 4) {
-                    std::string rootNote;
-                    std::cout << "Enter key (e.g., C, F#, Bb): ";
-                    std::cin >> rootNote;
+                if (choice >= 1 && choice <= 5) {
+                    auto rootSpelling = readNote("Enter key (e.g., C, F#, Bb): ");
+                    if (!rootSpelling) {
+                        std::cout << "Invalid key. Please try again." << std::endl;
+                        continue;
+                    }
                     
-                    // Find the MIDI value for the root note
-                    int rootIndex = -1;
-                    for (size_t i = 0; i < Note::ALL_NOTES.size(); ++i) {
-                        if (Note::ALL_NOTES[i].find(rootNote) != std::string::npos) {
-                            rootIndex = i;
-                            break;
-                        }
+                    DegreeProgression degrees;
+                    std::string title;
+                    if (choice <= 4) {
+                        const ProgressionPreset& preset = PROGRESSION_PRESETS[choice - 1];
+                        degrees = DegreeProgression::fromRomanNumerals(preset.mode, preset.numerals);
+                        title = preset.title;
+                    } else if (auto custom = readRomanNumerals()) {
+                        degrees = std::move(*custom);
+                        title = "Custom";
+                    } else {
+                        continue;
                     }
                     
-                    if (rootIndex != -1) {
-                        Note root(Note::ALL_NOTES[rootIndex], 60 + rootIndex);
-                        
-                        switch (choice) {
-                            case 1: {
-                                Scale majorScale = Scale::majorScale(root);
-                                ChordProgression progression = ChordProgression::createFromRomanNumerals(
-                                    majorScale, {"I", "IV", "V"}, root.getName() + " Major I-IV-V");
-                                progression.print();
-                                break;
-                            }
-                            case 2: {
-                                Scale majorScale = Scale::majorScale(root);
-                                ChordProgression progression = ChordProgression::createFromRomanNumerals(
-                                    majorScale, {"I", "V", "vi", "IV"}, root.getName() + " Major I-V-vi-IV (Pop)");
-                                progression.print();
-                                break;
-                            }
-                            case 3: {
-                                Scale majorScale = Scale::majorScale(root);
-                                ChordProgression progression = ChordProgression::createFromRomanNumerals(
-                                    majorScale, {"ii", "V", "I"}, root.getName() + " Major ii-V-I (Jazz)");
-                                progression.print();
-                                break;
-                            }
-                            case 4: {
-                                Scale minorScale = Scale::minorScale(root);
-                                ChordProgression progression = ChordProgression::createFromRomanNumerals(
-                                    minorScale, {"i", "iv", "v"}, root.getName() + " Minor i-iv-v");
-                                progression.print();
-                                break;
-                            }
+                    std::string name = std::string(rootSpelling->getName()) + " " + std::string(FormulaCatalog::get(degrees.getMode()).name) + " " + title;
+                    ChordProgression progression = degrees.realize(rootSpelling->getPitchClass(), name);
+                    progression.print();
+                    progression.printVoiceLeading();
+                } else if (choice == 6) {
+                    auto degrees = readRomanNumerals();
+                    if (!degrees) continue;
+                    
+                    std::vector<Chord> allKeys(12 * degrees->size(), Chord::major(Note(60)));
+                    degrees->realizeAllKeys(allKeys);
+                    for (int key = 0; key < 12; ++key) {
+                        std::cout << std::setw(3) << degrees->tonicSpelling(key).getName() << ":";
+                        for (std::size_t i = 0; i < degrees->size(); ++i) {
+                            std::cout << " " << std::setw(7) << allKeys[key * degrees->size() + i].getName();
                         }
-                    } else {
-                        std::cout << "Invalid key. Please try again." << std::endl;
+                        std::cout << std::endl;
                     }
+                } else if (choice == 7) {
+                    findKeyOfChordChart();
+                } else if (choice == 8) {
+                    analyzeChordChart();
+                } else if (choice == 9) {
+                    generatePracticeProgressions();
+                } else if (choice == 10) {
+                    reharmonizeChordChart();
+                }
+            }
+        }
+        
+        void findKeyOfChordChart() const {
+            auto chart = readChordChart("Enter chord symbols separated by spaces (e.g., Am F C G Am Dm E7 Am): ");
+            if (!chart || chart->empty()) return;
+            
+            KeyFinder finder;
+            std::cout << "Key estimate chord by chord:" << std::endl;
+            for (const Chord& chord : *chart) {
+                finder.push(chord);
+                std::cout << "  " << std::setw(7) << chord.getName() << " ->";
+                printKeyEstimate(finder);
+            }
+            std::cout << "Whole chart:" << std::endl;
+            printKeyRanking(*chart);
+        }
+        
+        static std::string keyName(const Key& key) {
+            return std::string(Speller::tonic(key).getName()) + " " + std::string(FormulaCatalog::get(key.type).name);
+        }
+        
+        static void printHarmonicAnalysis(std::span<const Chord> chart) {
+            HarmonicAnalysis analysis = HarmonicAnalyzer::analyze(chart);
+            std::size_t next = 0;
+            for (const KeyRegion& region : analysis.regions) {
+                if (region.begin > 0) {
+                    const Modulation& modulation = analysis.modulations[next++];
+                    std::cout << "  -- ";
+                    switch (modulation.kind) {
+                        case ModulationKind::Pivot:
+                            std::cout << "pivot chord " << chart[modulation.pivot].getName() << ": " << modulation.pivotBefore.getName()
+                                      << " in " << keyName(modulation.from) << " = " << modulation.pivotAfter.getName() << " in "
+                                      << keyName(modulation.to);
+                            break;
+                        case ModulationKind::Parallel:
+                            std::cout << "parallel key change";
+                            break;
+                        case ModulationKind::Direct:
+                            std::cout << "direct modulation";
+                            break;
+                    }
+                    std::cout << " --" << std::endl;
+                }
+                std::cout << "  " << keyName(region.key) << ":";
+                for (std::size_t i = region.begin; i < region.end; ++i) {
+                    std::cout << "  " << analysis.chords[i].chord.getName() << " " << analysis.chords[i].reading.getName();
                 }
+                std::cout << std::endl;
+            }
+        }
+        
+        void analyzeChordChart() const {
+            auto chart = readChordChart("Enter chord symbols separated by spaces (e.g., C Am Dm G7 C Am D7 G Em Am D7 G): ");
+            if (!chart || chart->empty()) return;
+            std::cout << "Roman numeral analysis:" << std::endl;
+            printHarmonicAnalysis(*chart);
+        }
+        
+        void generatePracticeProgressions() const {
+            auto tonic = readNote("Enter key (e.g., C, F#, Bb): ");
+            if (!tonic) {
+                std::cout << "Invalid key. Please try again." << std::endl;
+                return;
+            }
+            int modeChoice = 0;
+            std::uint64_t seed = 0;
+            std::cout << "Enter 1 for major or 2 for minor: ";
+            std::cin >> modeChoice;
+            std::cout << "Enter a seed (the same seed gives the same progressions): ";
+            std::cin >> seed;
+            
+            constexpr std::size_t COUNT = 4;
+            constexpr std::size_t LENGTH = 8;
+            ScaleType mode = modeChoice == 2 ? ScaleType::Minor : ScaleType::Major;
+            auto corpus = ProgressionCorpus::get(mode);
+            ProgressionGenerator generator(mode, corpus);
+            Key key{mode, static_cast<std::uint8_t>(tonic->getPitchClass())};
+            std::mt19937_64 engine(seed);
+            
+            std::cout << "Practice progressions in " << keyName(key) << ":" << std::endl;
+            for (std::size_t n = 0; n < COUNT; ++n) {
+                ChordProgression progression = generator.generate(engine, LENGTH).realize(key.tonic, "");
+                std::cout << "  " << (n + 1) << ".";
+                for (const Chord& chord : progression.getChords()) std::cout << " " << std::setw(6) << chord.getName();
+                std::cout << std::endl << "    ";
+                for (const Chord& chord : progression.getChords()) {
+                    std::cout << " " << std::setw(6) << HarmonicAnalyzer::read(chord, key).getName();
+                }
+                std::cout << std::endl;
+            }
+        }
+        
+        void reharmonizeChordChart() const {
+            auto chart = readChordChart("Enter chord symbols separated by spaces (e.g., Dm7 G7 Cmaj7 Am7 Dm7 G7 Cmaj7): ");
+            if (!chart || chart->empty()) return;
+            auto tune = readNoteList("Enter one melody note per chord, or leave empty: ", true);
+            if (!tune) return;
+            
+            std::vector<PitchClassSet> melody;
+            if (!tune->empty()) {
+                if (tune->size() != chart->size()) {
+                    std::cout << "Expected " << chart->size() << " melody notes; reharmonizing without the melody." << std::endl;
+                } else {
+                    for (const SpelledPitch& note : *tune) melody.push_back(PitchClassSet().with(note.getPitchClass()));
+                }
+            }
+            
+            ReharmonizationOptions options;
+            options.topK = 5;
+            auto results = Reharmonizer::instance().search(*chart, melody, options);
+            if (results.empty()) {
+                std::cout << "No reharmonizations found." << std::endl;
+                return;
+            }
+            
+            std::cout << "Best reharmonizations (lower cost is smoother):" << std::endl;
+            for (std::size_t r = 0; r < results.size(); ++r) {
+                const Reharmonization& result = results[r];
+                std::cout << "  " << (r + 1) << ".";
+                for (std::size_t i = 0; i < result.chords.size(); ++i) {
+                    bool sameSlot = i > 0 && result.chords[i - 1].slot == result.chords[i].slot;
+                    std::cout << (sameSlot ? " " : " | ") << result.chords[i].chord.getName();
+                }
+                std::cout << " |  (cost " << result.cost << (result.truncated ? ", search cut short" : "") << ")" << std::endl;
+                
+                std::string changes;
+                for (std::size_t i = 0; i < result.chords.size(); ++i) {
+                    const ReharmonizedChord& current = result.chords[i];
+                    // Once per slot, at the first chord its substitution brought in
+                    bool named = i > 0 && result.chords[i - 1].slot == current.slot &&
+                                 result.chords[i - 1].substitution != Substitution::Original;
+                    if (current.substitution == Substitution::Original || named) continue;
+                    if (!changes.empty()) changes += "; ";
+                    changes += (*chart)[current.slot].getName() + ": " + std::string(substitutionName(current.substitution));
+                }
+                std::cout << "     " << changes << std::endl;
             }
         }
         
@@ -860,16 +1134,28 @@ class MusicTheoryCompanion {
         
         void explainModes() const {
             std::cout << "\n=== Modes of the Major Scale ===" << std::endl;
+            static constexpr std::array<std::string_view, 7> DESCRIPTIONS = {
+                "The major scale itself, also called Ionian",
+                "Minor scale with raised 6th",
+                "Minor scale with lowered 2nd",
+                "Major scale with raised 4th",
+                "Major scale with lowered 7th",
+                "The natural minor scale, also called Aeolian",
+                "Diminished scale"
+            };
+            
+            Scale cMajor = Scale::majorScale(Note(60));
             std::cout << "Modes are scales derived from the major scale by starting on different scale degrees.\n\n"
-                    << "The seven modes of the C major scale are:\n"
-                    << "1. Ionian (C D E F G A B C) - The major scale itself\n"
-                    << "2. Dorian (D E F G A B C D) - Minor scale with raised 6th\n"
-                    << "3. Phrygian (E F G A B C D E) - Minor scale with lowered 2nd\n"
-                    << "4. Lydian (F G A B C D E F) - Major scale with raised 4th\n"
-                    << "5. Mixolydian (G A B C D E F G) - Major scale with lowered 7th\n"
-                    << "6. Aeolian (A B C D E F G A) - The natural minor scale\n"
-                    << "7. Locrian (B C D E F G A B) - Diminished scale\n\n"
-                    << "Each mode has a distinct character and sound:\n"
+                    << "The seven modes of the C major scale are:\n";
+            for (const Mode& mode : cMajor.modes()) {
+                std::cout << (mode.getDegree() + 1) << ". " << mode.getName() << " (";
+                for (Note note : mode.view(mode.getRoot().getMidiValue(), mode.getRoot().getMidiValue() + 12)) {
+                    std::cout << (note == mode.getRoot() ? "" : " ") << cMajor.spell(note.getPitchClass()).getName();
+                }
+                std::cout << ") - " << DESCRIPTIONS[mode.getDegree()] << "\n";
+            }
+            
+            std::cout << "\nEach mode has a distinct character and sound:\n"
                     << "- Ionian: bright, happy, stable\n"
                     << "- Dorian: minor but with a jazzy/bluesy character\n"
                     << "- Phrygian: exotic, Spanish flavor\n"
@@ -898,6 +1184,17 @@ class MusicTheoryCompanion {
                     << "6. Secondary Dominant\n"
                     << "   Using the dominant chord of a non-tonic chord to temporarily emphasize that chord.\n"
                     << "   Example: In C major, using D7 (V of G) before G to briefly emphasize G.\n";
+            
+            constexpr std::array<std::string_view, 16> EXAMPLE = {
+                "C", "F", "Dm", "G7", "C", "Am", "D7", "G", "Em", "Am", "D7", "G", "Gm", "Cm", "D7", "Gm"
+            };
+            std::vector<Chord> chart;
+            for (std::string_view symbol : EXAMPLE) {
+                auto parsed = SymbolParser::parseChord(symbol);
+                chart.push_back(Chord(parsed->type, Note(60 + parsed->root.getPitchClass()), parsed->root));
+            }
+            std::cout << "\nHow the progression analyzer reads a tune that moves to the dominant and then to the parallel minor:" << std::endl;
+            printHarmonicAnalysis(chart);
         }
         
         void explainChordExtensions() const {
@@ -922,7 +1219,18 @@ class MusicTheoryCompanion {
                     << "- #9 (sharp 9): raises the 9th by a half step\n"
                     << "- #11 (sharp 11): raises the 11th by a half step\n"
                     << "- b13 (flat 13): lowers the 13th by a half step\n\n"
-                    << "These extensions are commonly used in jazz, fusion, and progressive styles.\n";
+                    << "These extensions are commonly used in jazz, fusion, and progressive styles.\n\n"
+                    << "Every chord quality the companion knows, built on C:\n";
+            
+            for (std::size_t i = 0; i < FormulaCatalog::CHORDS.size(); ++i) {
+                Chord chord(static_cast<ChordType>(i), Note(60));
+                std::cout << "- " << std::left << std::setw(24) << chord.getFormula().name << std::setw(10) << chord.getName()
+                          << std::right << chord.getRootSpelling().getName();
+                for (auto interval : chord.getIntervals()) {
+                    std::cout << "-" << chord.spellTone(interval).getName();
+                }
+                std::cout << "\n";
+            }
         }
         
         void showPracticeExercisesMenu() {
@@ -980,16 +1288,10 @@ class MusicTheoryCompanion {
                 
                 std::string userAnswer;
                 std::cin >> userAnswer;
-                std::string correctNote = fretboard.getFretboard()[string][fret].getName();
-                // Convert to uppercase for comparison
-                std::transform(userAnswer.begin(), userAnswer.end(), userAnswer.begin(), ::toupper);
-                
-                // Get the correct note from the fretboard
-                correctNote = fretboard.fretboard[string][fret].getName();
-                std::transform(correctNote.begin(), correctNote.end(), correctNote.begin(), ::toupper);
                 
-                bool isCorrect = (correctNote.find(userAnswer) != std::string::npos) || 
-                                (userAnswer.find(correctNote) != std::string::npos);
+                // Any enharmonic spelling of the right pitch class counts
+                auto answer = SymbolParser::parseNote(userAnswer);
+                bool isCorrect = answer && answer->getPitchClass() == fretboard.fretboard[string][fret].getPitchClass();
                 
                 if (isCorrect) {
                     std::cout << "Correct! " << fretboard.fretboard[string][fret].getName() << " is the note." << std::endl;
@@ -1035,20 +1337,21 @@ class MusicTheoryCompanion {
             // Create a random seed
             std::srand(std::time(nullptr));
             
-            std::vector<std::string> chordTypes = {
-                "Major", "Minor", "Dominant 7", "Major 7", "Minor 7"
+            std::vector<ChordType> chordTypes = {
+                ChordType::Major, ChordType::Minor, ChordType::Dominant7, ChordType::Major7, ChordType::Minor7
             };
             
             for (int i = 1; i <= 3; ++i) {
                 // Generate random root note
                 int noteIndex = std::rand() % 12;
-                Note rootNote(Note::ALL_NOTES[noteIndex], 60 + noteIndex);
+                Note rootNote(60 + noteIndex);
                 
                 // Generate random chord type
                 int typeIndex = std::rand() % chordTypes.size();
-                std::string chordType = chordTypes[typeIndex];
+                Chord chord(chordTypes[typeIndex], rootNote);
+                std::string_view chordType = chord.getFormula().name;
                 
-                std::cout << "Exercise " << i << ": Construct a " << rootNote.getName() << " " << chordType << " chord." << std::endl;
+                std::cout << "Exercise " << i << ": Construct a " << chord.getRootSpelling().getName() << " " << chordType << " chord." << std::endl;
                 std::cout << "Enter the component notes separated by spaces: ";
                 
                 // Get user input
@@ -1056,24 +1359,10 @@ class MusicTheoryCompanion {
                 std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
                 std::getline(std::cin, userInput);
                 
-                // Create the correct chord
-                Chord chord("", {}, rootNote);
-                if (chordType == "Major") {
-                    chord = Chord::major(rootNote);
-                } else if (chordType == "Minor") {
-                    chord = Chord::minor(rootNote);
-                } else if (chordType == "Dominant 7") {
-                    chord = Chord::dominant7(rootNote);
-                } else if (chordType == "Major 7") {
-                    chord = Chord::major7(rootNote);
-                } else if (chordType == "Minor 7") {
-                    chord = Chord::minor7(rootNote);
-                }
-                
                 std::cout << "Correct answer: ";
-                auto notes = chord.getNotes();
-                for (const auto& note : notes) {
-                    std::cout << note.getName() << " ";
+                std::cout << chord.getRootSpelling().getName() << " ";
+                for (auto interval : chord.getIntervals()) {
+                    std::cout << chord.spellTone(interval).getName() << " ";
                 }
                 std::cout << std::endl;
             }